@@ -1,5 +1,6 @@
 #pragma once
 
+#include "./error.hpp"
 #include "./lex.hpp"
 #include "./render.hpp"
 
@@ -72,6 +73,35 @@ struct strand {};
 template <typename... Stmts>
 struct stmt_seq {};
 
+/**
+ * @brief Determine whether the name N is referenced anywhere within the AST, including within
+ * nested blocks. The target of an assignment is not a reference.
+ */
+template <token N, typename AST>
+constexpr bool uses_name_v = false;
+
+template <token N>
+constexpr bool uses_name_v<N, name<N>> = true;
+
+template <token N, typename W, typename F, typename X>
+constexpr bool uses_name_v<N, dyad<W, F, X>>
+    = uses_name_v<N, W> or uses_name_v<N, F> or uses_name_v<N, X>;
+
+template <token N, typename F, typename X>
+constexpr bool uses_name_v<N, monad<F, X>> = uses_name_v<N, F> or uses_name_v<N, X>;
+
+template <token N, typename Inner>
+constexpr bool uses_name_v<N, block<Inner>> = uses_name_v<N, Inner>;
+
+template <token N, typename ID, typename E>
+constexpr bool uses_name_v<N, assignment<ID, E>> = uses_name_v<N, E>;
+
+template <token N, typename... Elems>
+constexpr bool uses_name_v<N, strand<Elems...>> = (uses_name_v<N, Elems> or ...);
+
+template <token N, typename... Stmts>
+constexpr bool uses_name_v<N, stmt_seq<Stmts...>> = (uses_name_v<N, Stmts> or ...);
+
 template <typename AST>
 struct render_not_implemented {};
 
@@ -191,7 +221,7 @@ template <typename Code>
 constexpr auto render_v<block<Code>> = cx_fmt_v<"{{{}}}", render_v<Code>>;
 
 template <auto Value>
-constexpr auto render_v<Const<Value>> = render::integer_v<Value>;
+constexpr auto render_v<Const<Value>> = render_value_v<typename Const<Value>::type, Value>;
 
 template <typename... Elems>
 constexpr auto render_v<strand<Elems...>> = cx_str_join_v<"‿", detail::render_operand_v<Elems>...>;
@@ -201,6 +231,15 @@ constexpr auto render() noexcept {
     return render_v<T>;
 }
 
+/// An argument of an error message that renders the code of an AST node
+template <typename AST>
+struct code_arg : err::deferred_arg {
+    constexpr static auto render() noexcept { return render_v<AST>; }
+};
+
+template <typename AST>
+constexpr code_arg<AST> code_arg_v{};
+
 template <typename F>
     requires requires { F::dyadic_name(); }
 constexpr auto dyadic_name() {
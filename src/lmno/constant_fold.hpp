@@ -0,0 +1,221 @@
+#pragma once
+
+#include "./ast.hpp"
+#include "./concepts/stateless.hpp"
+#include "./concepts/structural.hpp"
+#include "./const.hpp"
+#include "./define.hpp"
+#include "./invoke.hpp"
+
+#include <neo/invoke.hpp>
+
+namespace lmno {
+
+namespace cfold_detail {
+
+/**
+ * @brief Determine whether the given name is the target of an assignment anywhere within the AST
+ */
+template <lex::token N, typename AST>
+constexpr bool assigns_v = false;
+
+template <lex::token N, typename W, typename F, typename X>
+constexpr bool assigns_v<N, ast::dyad<W, F, X>>
+    = assigns_v<N, W> or assigns_v<N, F> or assigns_v<N, X>;
+
+template <lex::token N, typename F, typename X>
+constexpr bool assigns_v<N, ast::monad<F, X>> = assigns_v<N, F> or assigns_v<N, X>;
+
+template <lex::token N, typename Inner>
+constexpr bool assigns_v<N, ast::block<Inner>> = assigns_v<N, Inner>;
+
+template <lex::token N, lex::token M, typename E>
+constexpr bool assigns_v<N, ast::assignment<ast::name<M>, E>> = N == M or assigns_v<N, E>;
+
+template <lex::token N, typename... Elems>
+constexpr bool assigns_v<N, ast::strand<Elems...>> = (assigns_v<N, Elems> or ...);
+
+template <lex::token N, typename... Stmts>
+constexpr bool assigns_v<N, ast::stmt_seq<Stmts...>> = (assigns_v<N, Stmts> or ...);
+
+/**
+ * @brief Match a name that will always resolve to its global definition within Program
+ */
+template <lex::token N, typename Program>
+concept global_name = not assigns_v<N, Program>;
+
+template <lex::token N>
+using define_t = neo::remove_cvref_t<decltype(lmno::define<N>)>;
+
+/**
+ * @brief Match a call of a stateless function on typed constants that will be invoked directly by
+ * lmno::invoke, and which returns another typed constant.
+ */
+template <typename F, typename... Args>
+concept typed_constant_call =                                          //
+    stateless<F>                                                       //
+    and non_error<F>                                                   //
+    and (typed_constant<Args> and ...)                                 //
+    and invoke_detail::check_invocable_without_error<const F&, Args...>  //
+    and typed_constant<neo::remove_cvref_t<neo::invoke_result_t<const F&, Args...>>>;
+
+/**
+ * @brief Match a call whose evaluation by default_sema would go through lmno::invoke with every
+ * argument unconst'd, and then be wrapped in a Const<> by const_wrapping_invoker.
+ *
+ * We check the same conditions that lmno::invoke would use to pick that invoker, but can skip the
+ * rest of its machinery (error rendering and the cast-combination search) since we are only
+ * interested in the one outcome.
+ */
+template <typename F, typename... Args>
+concept unconst_call =                                                      //
+    stateless<F>                                                            //
+    and non_error<F>                                                        //
+    and (typed_constant<Args> and ...)                                      //
+    and not invoke_detail::check_invocable_without_error<const F&, Args...>  //
+    and invoke_detail::check_invocable_without_error<const F&, unconst_t<Args>...>;
+
+// For two arguments, lmno::invoke would try unconst'ing each argument alone before both
+template <typename F, typename W, typename X>
+concept unconst_dyad_call
+    = unconst_call<F, W, X>
+    and not invoke_detail::check_invocable_without_error<const F&, unconst_t<W>, X>
+    and not invoke_detail::check_invocable_without_error<const F&, W, unconst_t<X>>;
+
+template <typename F, typename... Args>
+constexpr auto call_value() {
+    return neo::invoke(F{}, lmno::unconst(Args{})...);
+}
+
+/**
+ * @brief Match a call that can be computed once at compile-time and placed in a Const<>
+ */
+template <typename F, typename... Args>
+concept const_result =  //
+    requires {
+        requires not stateless<decltype(call_value<F, Args...>())>;
+        requires structural<decltype(call_value<F, Args...>())>;
+        typename Const<call_value<F, Args...>()>;
+    };
+
+/**
+ * @brief Compute the typed constant that results from calling F with Args. Has no nested `type` if
+ * the call cannot be folded.
+ */
+template <typename F, typename... Args>
+struct call_folder {};
+
+template <typename F, typename... Args>
+    requires typed_constant_call<F, Args...>
+struct call_folder<F, Args...> {
+    using type = neo::remove_cvref_t<neo::invoke_result_t<const F&, Args...>>;
+};
+
+template <typename F, typename X>
+    requires unconst_call<F, X> and const_result<F, X>
+struct call_folder<F, X> {
+    using type = Const<call_value<F, X>()>;
+};
+
+template <typename F, typename W, typename X>
+    requires unconst_dyad_call<F, W, X> and const_result<F, W, X>
+struct call_folder<F, W, X> {
+    using type = Const<call_value<F, W, X>()>;
+};
+
+template <lex::token N, typename Program, typename... Args>
+concept foldable_call = global_name<N, Program>
+    and requires { typename call_folder<define_t<N>, Args...>::type; };
+
+}  // namespace cfold_detail
+
+/**
+ * @brief Rewrites an AST, collapsing subtrees that are entirely constant into a single Const<>
+ *
+ * @tparam AST The AST node being folded
+ * @tparam Program The root of the AST, used to check for assignments that shadow global names.
+ *
+ * A dyad or monad is folded if its function is a name that refers to a stateless definition,
+ * every operand is (or has been folded into) a typed constant, and evaluating it with
+ * default_sema would produce a typed constant, either directly or by calling the function on the
+ * unconst'd operands and wrapping the result in a Const<>. This produces the same result as
+ * evaluation, but without instantiating the full lmno::invoke machinery for each node. Anything
+ * else is left as-is, with its children folded.
+ */
+template <typename AST, typename Program = AST>
+struct const_folder {
+    using type = AST;
+};
+
+template <typename AST, typename Program = AST>
+using constant_fold_t = const_folder<AST, Program>::type;
+
+// A name that is bound to a typed constant is itself a constant
+template <lex::token N, typename Program>
+    requires cfold_detail::global_name<N, Program>
+    and typed_constant<cfold_detail::define_t<N>>
+struct const_folder<ast::name<N>, Program> {
+    using type = cfold_detail::define_t<N>;
+};
+
+namespace cfold_detail {
+
+template <typename F, typename Program, typename... Args>
+struct fold_call;
+
+// By default, we cannot fold the call
+template <typename F, typename Program, typename X>
+struct fold_call<F, Program, X> {
+    using type = ast::monad<constant_fold_t<F, Program>, X>;
+};
+
+template <typename F, typename Program, typename W, typename X>
+struct fold_call<F, Program, W, X> {
+    using type = ast::dyad<W, constant_fold_t<F, Program>, X>;
+};
+
+template <lex::token N, typename Program, typename X>
+    requires foldable_call<N, Program, X>
+struct fold_call<ast::name<N>, Program, X> : call_folder<define_t<N>, X> {};
+
+template <lex::token N, typename Program, typename W, typename X>
+    requires foldable_call<N, Program, W, X>
+struct fold_call<ast::name<N>, Program, W, X> : call_folder<define_t<N>, W, X> {};
+
+}  // namespace cfold_detail
+
+template <typename F, typename X, typename Program>
+struct const_folder<ast::monad<F, X>, Program>
+    : cfold_detail::fold_call<F, Program, constant_fold_t<X, Program>> {};
+
+template <typename W, typename F, typename X, typename Program>
+struct const_folder<ast::dyad<W, F, X>, Program>
+    : cfold_detail::fold_call<F, Program, constant_fold_t<W, Program>, constant_fold_t<X, Program>> {
+};
+
+// A dyad with "·" on the left is evaluated as a monad
+template <typename F, typename X, typename Program>
+struct const_folder<ast::dyad<ast::nothing, F, X>, Program>
+    : const_folder<ast::monad<F, X>, Program> {};
+
+template <typename Inner, typename Program>
+struct const_folder<ast::block<Inner>, Program> {
+    using type = ast::block<constant_fold_t<Inner, Program>>;
+};
+
+template <typename ID, typename E, typename Program>
+struct const_folder<ast::assignment<ID, E>, Program> {
+    using type = ast::assignment<ID, constant_fold_t<E, Program>>;
+};
+
+template <typename... Elems, typename Program>
+struct const_folder<ast::strand<Elems...>, Program> {
+    using type = ast::strand<constant_fold_t<Elems, Program>...>;
+};
+
+template <typename... Stmts, typename Program>
+struct const_folder<ast::stmt_seq<Stmts...>, Program> {
+    using type = ast::stmt_seq<constant_fold_t<Stmts, Program>...>;
+};
+
+}  // namespace lmno
@@ -0,0 +1,41 @@
+#include "./constant_fold.hpp"
+
+#include "./eval.hpp"
+#include "./parse.hpp"
+#include "./stdlib.hpp"
+
+namespace ast = lmno::ast;
+using lmno::Const;
+using lmno::ConstInt64;
+using lmno::constant_fold_t;
+using lmno::parse_t;
+
+template <lmno::cx_str S>
+using folded = constant_fold_t<parse_t<S>>;
+
+// Entirely-constant expressions collapse to a single Const<>
+static_assert(std::same_as<folded<"2+3">, ConstInt64<5>>);
+static_assert(std::same_as<folded<"1 + 2 × 3 - 4">, ConstInt64<-1>>);
+static_assert(std::same_as<folded<"- 4+3">, ConstInt64<-7>>);
+static_assert(std::same_as<folded<"4÷3">, Const<lmno::rational{4, 3}>>);
+static_assert(std::same_as<folded<"·-4">, ConstInt64<-4>>);
+
+// Constant subexpressions fold within larger expressions and blocks
+static_assert(std::same_as<folded<"{ω + 2×3}">,
+                           ast::block<ast::dyad<ast::name<"ω">, ast::name<"+">, ConstInt64<6>>>>);
+static_assert(std::same_as<folded<"(2+3)‿ω">, ast::strand<ConstInt64<5>, ast::name<"ω">>>);
+
+// Non-constant operands are not folded
+static_assert(std::same_as<folded<"ω+1">, parse_t<"ω+1">>);
+
+// Functions producing stateless values (e.g. ranges of constants) are left to evaluation
+static_assert(std::same_as<folded<"⍳4">, parse_t<"⍳4">>);
+
+// A name that is assigned anywhere in the program is never folded
+static_assert(std::same_as<folded<"+ ← -; 2+3">,
+                           ast::stmt_seq<ast::assignment<ast::name<"+">, ast::name<"-">>,
+                                         ast::dyad<ConstInt64<2>, ast::name<"+">, ConstInt64<3>>>>);
+
+// Evaluation results are unchanged
+static_assert(lmno::eval<"1 + 2 × 3 - 4">() == ConstInt64<-1>{});
+static_assert(lmno::eval<"{ω + 2×3}">()(4) == 10);
@@ -5,7 +5,9 @@
 #include "./lex.hpp"
 
 #include <neo/tuple.hpp>
+#include <neo/type_traits.hpp>
 #include <tuple>
+#include <type_traits>
 
 namespace lmno {
 
@@ -69,10 +71,44 @@ struct default_context {
      * @return constexpr auto
      */
     template <typename... Items>
-    constexpr auto bind(Items&&... items) const noexcept {
+    constexpr auto bind(Items&&... items) const& noexcept {
         auto new_scope = _scope.bind(NEO_FWD(items)...);
         return lmno::default_context{NEO_MOVE(new_scope)};
     }
+
+    // When the current context is a temporary, its values are moved into the new context
+    template <typename... Items>
+    constexpr auto bind(Items&&... items) && noexcept {
+        auto new_scope = NEO_MOVE(_scope).bind(NEO_FWD(items)...);
+        return lmno::default_context{NEO_MOVE(new_scope)};
+    }
+
+    /**
+     * @brief Create a new context with new names bound, which refers to the values of the current
+     * context rather than copying them.
+     *
+     * The new context must not outlive the current context.
+     */
+    template <typename... Items>
+    constexpr auto bind_borrowed(Items&&... items) const noexcept {
+        auto new_scope = _scope.bind_borrowed(NEO_FWD(items)...);
+        return lmno::default_context{NEO_MOVE(new_scope)};
+    }
+
+    /**
+     * @brief Create a new context that retains only some of the names in the current scope.
+     *
+     * @tparam Keep A type with a static `bool` member template `test<Name>`, which is true for
+     * each name that should be kept.
+     *
+     * The new context holds its own copy of each value, even if the current context only refers
+     * to it.
+     */
+    template <typename Keep>
+    constexpr auto only() const noexcept {
+        auto new_scope = _scope.template only<Keep>();
+        return lmno::default_context{NEO_MOVE(new_scope)};
+    }
 };
 LMNO_AUTO_CTAD_GUIDE(default_context);
 
@@ -101,22 +137,62 @@ struct name_value_pairs;
 template <lex::token... Name, typename... Type>
 struct name_value_pairs<named_value<Name, Type>...> : named_value<Name, Type>... {};
 
-template <typename New, typename Old, typename Acc = meta::list<>>
+/**
+ * A list-concatenating box. Lists are joined with a fold over operator+, which gives a constant
+ * instantiation depth regardless of how many lists are joined.
+ */
+template <typename L>
+struct cat_box {
+    using type = L;
+};
+
+template <typename... Ts, typename... Us>
+cat_box<list<Ts..., Us...>> operator+(cat_box<list<Ts...>>, cat_box<list<Us...>>);
+
+template <typename... Lists>
+using concat_t = decltype((cat_box<list<>>{} + ... + cat_box<Lists>{}))::type;
+
+// A single-element list of Old, or an empty list if Old is shadowed by one of News
+template <typename Old, typename... News>
+struct unshadowed {
+    using type = std::conditional_t<((News::name == Old::name) or ...), list<>, list<Old>>;
+};
+
+// A single-element list of Pair if Keep is true, otherwise an empty list
+template <bool Keep, typename Pair>
+struct keep_if {
+    using type = list<>;
+};
+
+template <typename Pair>
+struct keep_if<true, Pair> {
+    using type = list<Pair>;
+};
+
+// A pair that refers to the value of another pair
+template <typename Pair>
+struct borrow;
+
+template <lex::token Name, typename T>
+struct borrow<named_value<Name, T>> {
+    using type = named_value<Name, const std::remove_reference_t<T>&>;
+};
+
+template <typename New, typename Old>
 struct replace_named;
 
-template <typename... News, typename Old1, typename... Olds, typename... Acc>
-struct replace_named<list<News...>, list<Old1, Olds...>, list<Acc...>>
-    : replace_named<list<News...>, list<Olds...>, list<Acc..., Old1>> {};
+template <typename... News, typename... Olds>
+struct replace_named<list<News...>, list<Olds...>> {
+    using keep = concat_t<typename unshadowed<Olds, News...>::type...>;
+    using type = concat_t<keep, list<News...>>;
+};
 
-template <typename... News, typename Old1, typename... Olds, typename... Acc>
-    requires((News::name == Old1::name) or ...)
-struct replace_named<list<News...>, list<Old1, Olds...>, list<Acc...>>
-    : replace_named<list<News...>, list<Olds...>, list<Acc...>> {};
+template <typename Keep, typename... News>
+struct borrow_kept;
 
-template <typename... News, typename... Acc>
-struct replace_named<list<News...>, list<>, list<Acc...>> {
-    using keep = list<Acc...>;
-    using type = list<Acc..., News...>;
+template <typename... Keep, typename... News>
+struct borrow_kept<list<Keep...>, News...> {
+    using type = list<typename borrow<Keep>::type..., News...>;
 };
 
 }  // namespace detail
@@ -133,8 +209,10 @@ struct scope<named_value<Names, Types>...> {
     constexpr scope(tuple&& t) noexcept
         : _values(NEO_MOVE(t)) {}
 
+    // Resolved by overload resolution against the bases of the tuple, rather than by comparing
+    // against every name in scope.
     template <lex::token N>
-    constexpr static bool has_name_v = ((N == Names) or ...);
+    constexpr static bool has_name_v = requires(const tuple& t) { detail::get_named<N>(t); };
 
     template <lex::token Name>
     using named_t = decltype(detail::get_named<Name>(NEO_DECLVAL(tuple)).get());
@@ -146,10 +224,11 @@ struct scope<named_value<Names, Types>...> {
     }
 
     template <typename... Pairs>
-    constexpr auto bind(Pairs&&... ps) const noexcept {
-        using to_add    = meta::list<Pairs...>;
-        using current   = meta::rebind<tuple, meta::list>;
-        using replace   = detail::replace_named<to_add, current>;
+    using replace_t = detail::replace_named<meta::list<Pairs...>, meta::rebind<tuple, meta::list>>;
+
+    template <typename... Pairs>
+    constexpr auto bind(Pairs&&... ps) const& noexcept {
+        using replace   = replace_t<Pairs...>;
         using new_list  = replace::type;
         using keep_list = replace::keep;
         return this->_bind_copy(static_cast<keep_list*>(nullptr),
@@ -157,6 +236,35 @@ struct scope<named_value<Names, Types>...> {
                                 NEO_FWD(ps)...);
     }
 
+    template <typename... Pairs>
+    constexpr auto bind(Pairs&&... ps) && noexcept {
+        using replace   = replace_t<Pairs...>;
+        using new_list  = replace::type;
+        using keep_list = replace::keep;
+        return NEO_MOVE(*this)._bind_move(static_cast<keep_list*>(nullptr),
+                                          static_cast<new_list*>(nullptr),
+                                          NEO_FWD(ps)...);
+    }
+
+    template <typename... Pairs>
+    constexpr auto bind_borrowed(Pairs&&... ps) const noexcept {
+        using replace   = replace_t<Pairs...>;
+        using keep_list = replace::keep;
+        using new_list  = detail::borrow_kept<keep_list, Pairs...>::type;
+        return this->_bind_copy(static_cast<keep_list*>(nullptr),
+                                static_cast<new_list*>(nullptr),
+                                NEO_FWD(ps)...);
+    }
+
+    template <typename Keep>
+    constexpr auto only() const noexcept {
+        using keep_list = detail::concat_t<typename detail::keep_if<
+            Keep::template test<Names>,
+            named_value<Names, neo::remove_cvref_t<Types>>>::type...>;
+        return this->_bind_copy(static_cast<keep_list*>(nullptr),
+                                static_cast<keep_list*>(nullptr));
+    }
+
     template <lex::token... Keep, typename... KeepTypes, typename... NewPairs, typename... AddPairs>
     constexpr auto _bind_copy(meta::list<named_value<Keep, KeepTypes>...>*,
                               meta::list<NewPairs...>*,
@@ -165,8 +273,86 @@ struct scope<named_value<Names, Types>...> {
                                                          {NEO_FWD(ps)}...};
         return scope<NewPairs...>(NEO_MOVE(tup));
     }
+
+    template <lex::token... Keep, typename... KeepTypes, typename... NewPairs, typename... AddPairs>
+    constexpr auto _bind_move(meta::list<named_value<Keep, KeepTypes>...>*,
+                              meta::list<NewPairs...>*,
+                              AddPairs&&... ps) && noexcept {
+        auto tup = detail::name_value_pairs<NewPairs...>{
+            {NEO_MOVE(detail::get_named<Keep>(_values).get())}...,
+            {NEO_FWD(ps)}...};
+        return scope<NewPairs...>(NEO_MOVE(tup));
+    }
+};
+
+/**
+ * @brief A context that layers a scope of local names over another context, which it refers to
+ * rather than copying. Names that are not in the local scope are looked up in the outer context.
+ *
+ * Closures use this to bind α and ω for a call, so the cost of a call does not depend on how many
+ * names the closure has captured. The layered context must not outlive the outer context.
+ *
+ * @tparam Scope The scope of local names
+ * @tparam Outer The context that is layered under the local names
+ */
+template <typename Scope, typename Outer>
+struct layered_context {
+    NEO_NO_UNIQUE_ADDRESS Scope _scope;
+    const Outer*                _outer;
+
+    template <lex::token Name>
+    constexpr decltype(auto) get() const noexcept {
+        if constexpr (Scope::template has_name_v<Name>) {
+            return _scope.template get<Name>();
+        } else {
+            return _outer->template get<Name>();
+        }
+    }
+
+    // New names are bound in the local scope, over the same outer context
+    template <typename... Items>
+    constexpr auto bind(Items&&... items) const& noexcept {
+        auto new_scope = _scope.bind(NEO_FWD(items)...);
+        return lmno::layered_context<decltype(new_scope), Outer>{NEO_MOVE(new_scope), _outer};
+    }
+
+    template <typename... Items>
+    constexpr auto bind(Items&&... items) && noexcept {
+        auto new_scope = NEO_MOVE(_scope).bind(NEO_FWD(items)...);
+        return lmno::layered_context<decltype(new_scope), Outer>{NEO_MOVE(new_scope), _outer};
+    }
+
+    template <typename... Items>
+    constexpr auto bind_borrowed(Items&&... items) const noexcept {
+        auto new_scope = _scope.bind_borrowed(NEO_FWD(items)...);
+        return lmno::layered_context<decltype(new_scope), Outer>{NEO_MOVE(new_scope), _outer};
+    }
+
+    /**
+     * @brief Create a context that holds its own copy of the kept names, from both the local scope
+     * and the outer context. The new context does not refer to the outer context, so it may
+     * outlive it.
+     *
+     * If the outer context does not provide only<>(), all of the outer context is kept.
+     */
+    template <typename Keep>
+    constexpr auto only() const noexcept {
+        auto local = _scope.template only<Keep>();
+        if constexpr (requires { _outer->template only<Keep>(); }) {
+            return _bind_locals(_outer->template only<Keep>(), NEO_MOVE(local));
+        } else {
+            return _bind_locals(*_outer, NEO_MOVE(local));
+        }
+    }
+
+    template <typename Ctx, lex::token... Names, typename... Types>
+    constexpr static auto _bind_locals(Ctx&& ctx, scope<named_value<Names, Types>...>&& local) {
+        return NEO_FWD(ctx).bind(
+            lmno::make_named<Names>(NEO_MOVE(detail::get_named<Names>(local._values).get()))...);
+    }
 };
 
+
 template <lex::token... Names, typename... Types>
 constexpr bool enable_stateless_v<scope<named_value<Names, Types>...>> = (stateless<Types> and ...);
 
@@ -174,4 +360,8 @@ template <lex::token... Names, typename... Types>
 constexpr bool enable_stateless_v<default_context<scope<named_value<Names, Types>...>>>
     = (stateless<Types> and ...);
 
+// A layered context refers to its outer context, so it is never stateless
+template <typename Scope, typename Outer>
+constexpr bool enable_stateless_v<layered_context<Scope, Outer>> = false;
+
 }  // namespace lmno
@@ -1,6 +1,8 @@
 #include "./context.hpp"
 
+#include <array>
 #include <string_view>
+#include <utility>
 
 using namespace lmno;
 
@@ -24,6 +26,52 @@ constexpr auto s4 = s3.bind(make_named<"dog">('a'));
 static_assert(s4.get<"dog">() == 'a');
 static_assert(s4.get<"cat">() == "I am a string");
 
+// Rebinding a name moves it to the end, and keeps the other names in order
+static_assert(std::same_as<decltype(s4),
+                           const scope<named_value<"cat", std::string_view>, named_value<"dog", char>>>);
+
+constexpr auto s5 = s4.bind(make_named<"cat">(1), make_named<"eel">(2), make_named<"fox">(3));
+static_assert(not s5.has_name_v<"ant">);
+static_assert(s5.get<"dog">() == 'a');
+static_assert(s5.get<"cat">() == 1);
+static_assert(s5.get<"fox">() == 3);
+
+// Binding to a temporary scope moves its values into the new scope
+constexpr bool check_bind_move() {
+    auto s = scope<>{}.bind(make_named<"v">(std::array{1, 2, 3}));
+    auto t = std::move(s).bind(make_named<"w">(4));
+    return t.get<"v">()[2] == 3 and t.get<"w">() == 4;
+}
+static_assert(check_bind_move());
+
+// A borrowing bind refers to the kept values instead of copying them
+static_assert(std::same_as<decltype(s3.bind_borrowed(make_named<"eel">(2))),
+                           scope<named_value<"dog", const int&>,
+                                 named_value<"cat", const std::string_view&>,
+                                 named_value<"eel", int>>>);
+static_assert(&s3.bind_borrowed(make_named<"eel">(2)).get<"dog">() == &s3.get<"dog">());
+
+// A layered context looks up names in its own scope first, then refers to the outer context
+constexpr auto c3 = default_context{s3};
+constexpr auto l1 = layered_context<scope<named_value<"dog", int>>, decltype(c3)>{
+    scope<>{}.bind(make_named<"dog">(7)),
+    &c3,
+};
+static_assert(l1.get<"dog">() == 7);
+static_assert(&l1.get<"cat">() == &c3.get<"cat">());
+static_assert(&l1.bind(make_named<"eel">(2)).get<"cat">() == &c3.get<"cat">());
+
+// Keeping names from a layered context copies them from both layers. The local names shadow the
+// outer ones.
+struct keep_dog_cat {
+    template <lex::token Name>
+    constexpr static bool test = Name == lex::token{"dog"} or Name == lex::token{"cat"};
+};
+static_assert(std::same_as<decltype(l1.only<keep_dog_cat>()),
+                           default_context<scope<named_value<"cat", std::string_view>,
+                                                 named_value<"dog", int>>>>);
+static_assert(l1.only<keep_dog_cat>().get<"dog">() == 7);
+
 struct nonempty {
     std::plus<> p;
 };
@@ -5,9 +5,17 @@
 
 namespace lmno {
 
+namespace msg {
+
+struct undefined_name {
+    static constexpr cx_str text = "The name {:'} is not defined";
+};
+
+}  // namespace msg
+
 template <cx_str Name>
 constexpr auto make_undefined_name() {
-    return err::make_error<"The name {:'} is not defined", Name>();
+    return err::msg_error_t<msg::undefined_name, Name>{};
 }
 
 template <lex::token Name>
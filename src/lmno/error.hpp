@@ -1,5 +1,6 @@
 #pragma once
 
+#include "./render.hpp"
 #include "./string.hpp"
 
 #include <neo/concepts.hpp>
@@ -28,14 +29,100 @@ struct [[nodiscard]] error_type : error_base {
     static constexpr const auto& message = Message;
 };
 
+/**
+ * @brief Base class of the arguments of an error message that are rendered only when the message
+ * is rendered. Derived classes provide a static render() that returns a cx_str.
+ */
+struct deferred_arg {};
+
+/**
+ * @brief Match a type that may be used as an argument of an error message
+ */
+template <typename T>
+concept message_arg = lmno::cx_sized_string<T> or neo::derived_from<T, deferred_arg>;
+
+/// An argument of an error message that renders the type T
+template <typename T>
+struct type_arg : deferred_arg {
+    constexpr static auto render() noexcept { return render::type_v<T>; }
+};
+
+template <typename T>
+constexpr type_arg<T> type_arg_v{};
+
+/// An argument of an error message that renders each of Ts, quoted and separated by commas
+template <typename... Ts>
+struct type_list_arg : deferred_arg {
+    constexpr static auto render() noexcept {
+        return cx_str_join_v<", ", cx_fmt_v<"{:'}", render::type_v<Ts>>...>;
+    }
+};
+
+template <typename... Ts>
+constexpr type_list_arg<Ts...> type_list_arg_v{};
+
+/**
+ * @brief Match an interned error message: A type whose static member "text" is the format string
+ * of the message.
+ *
+ * Errors refer to their message by this type instead of by the text itself, so the text is not
+ * spelled out in the name of every error (and every function that returns one).
+ */
+template <typename T>
+concept message_type = lmno::cx_sized_string<neo::remove_cvref_t<decltype(T::text)>>;
+
+/// A message that is not interned: The format string is part of the message's type
+template <cx_str Fmt>
+struct literal_message {
+    static constexpr const auto& text = Fmt;
+};
+
+/**
+ * @brief Class template of an error whose message is given by a format string and its arguments.
+ *
+ * The message is only formatted when it is rendered (see message_v and render_error), so a
+ * program that creates this error without ever displaying it does not pay for the formatting.
+ *
+ * @tparam Message The message_type that holds the format string of the message
+ * @tparam Child A child error that provides additional context, or void
+ * @tparam Items The arguments of the message. Each is either a string or a deferred_arg.
+ */
+template <message_type Message, typename Child, auto... Items>
+struct [[nodiscard]] fmt_error_type : error_base {
+    // The child type associated with this error, or void
+    using child = Child;
+};
+
+namespace detail {
+
+template <auto Item>
+constexpr auto render_arg() noexcept {
+    if constexpr (lmno::cx_sized_string<decltype(Item)>) {
+        return Item;
+    } else {
+        return decltype(Item)::render();
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief The message string of an error type. Rendering the message happens here, and only here.
+ */
+template <typename Error>
+constexpr auto message_v = Error::message;
+
+template <message_type Message, typename Child, auto... Items>
+constexpr auto message_v<fmt_error_type<Message, Child, Items...>>
+    = cx_fmt_v<Message::text, detail::render_arg<Items>()...>;
+
 /**
  * @brief Construct an error object using a string format message
  */
 template <cx_str Fmt, auto... Items>
-    requires(lmno::cx_sized_string<decltype(Items)> and ...)
+    requires(message_arg<decltype(Items)> and ...)
 constexpr auto make_error() {
-    constexpr auto s = lmno::cx_fmt_v<Fmt, Items...>;
-    return error_type<s>{};
+    return fmt_error_type<literal_message<Fmt>, void, Items...>{};
 }
 
 /**
@@ -43,19 +130,51 @@ constexpr auto make_error() {
  * child error type
  */
 template <typename Child, cx_str Fmt, auto... Items>
-    requires(lmno::cx_sized_string<decltype(Items)> and ...)
+    requires(message_arg<decltype(Items)> and ...)
 constexpr auto make_error() {
-    constexpr auto s = lmno::cx_fmt_v<Fmt, Items...>;
-    return error_type<s, Child>{};
+    return fmt_error_type<literal_message<Fmt>, Child, Items...>{};
 }
 
 template <cx_str Fmt, auto... Items>
-    requires(lmno::cx_sized_string<decltype(Items)> and ...)
-using fmt_error_t = decltype(make_error<Fmt, Items...>());
+    requires(message_arg<decltype(Items)> and ...)
+using fmt_error_t = fmt_error_type<literal_message<Fmt>, void, Items...>;
 
 template <typename Child, cx_str Fmt, auto... Items>
-    requires(lmno::cx_sized_string<decltype(Items)> and ...)
-using fmt_errorex_t = decltype(make_error<Child, Fmt, Items...>());
+    requires(message_arg<decltype(Items)> and ...)
+using fmt_errorex_t = fmt_error_type<literal_message<Fmt>, Child, Items...>;
+
+/// An error with the interned message Message
+template <message_type Message, auto... Items>
+    requires(message_arg<decltype(Items)> and ...)
+using msg_error_t = fmt_error_type<Message, void, Items...>;
+
+/// An error with the interned message Message, with the given child error type
+template <typename Child, message_type Message, auto... Items>
+    requires(message_arg<decltype(Items)> and ...)
+using msg_errorex_t = fmt_error_type<Message, Child, Items...>;
+
+/**
+ * @brief Render the message of an error, followed by the messages of each of its children
+ */
+template <typename Error>
+constexpr auto render_error(Error) {
+    if constexpr (std::same_as<typename Error::child, void>) {
+        return message_v<Error>;
+    } else {
+        constexpr auto next   = render_error(typename Error::child{});
+        constexpr auto indent = cx_str_replace<next, cx_str{"\n"}, cx_str{"\n  "}>();
+        return cx_fmt_v<"{}\n\n→ because:\n\n  {}", message_v<Error>, indent>;
+    }
+}
+
+/// An argument of an error message that renders the error E and all of its children
+template <typename E>
+struct error_arg : deferred_arg {
+    constexpr static auto render() noexcept { return render_error(E{}); }
+};
+
+template <typename E>
+constexpr error_arg<E> error_arg_v{};
 
 }  // namespace lmno::err
 
@@ -0,0 +1,61 @@
+#include "./error.hpp"
+
+#include <string_view>
+
+using namespace lmno;
+
+namespace {
+
+struct widget {};
+
+}  // namespace
+
+template <>
+constexpr auto lmno::render::type_v<widget> = cx_str{"widget"};
+
+namespace {
+
+// The arguments of a formatted error are kept in its type, and are not yet rendered
+using leaf = err::fmt_error_t<"Cannot {} a {:'}", cx_str{"frob"}, err::type_arg_v<widget>>;
+static_assert(any_error<leaf>);
+static_assert(std::same_as<leaf,
+                           err::fmt_error_type<err::literal_message<"Cannot {} a {:'}">,
+                                               void,
+                                               cx_str{"frob"},
+                                               err::type_arg_v<widget>>>);
+
+// The message is formatted when it is asked for
+static_assert(std::string_view(err::message_v<leaf>) == "Cannot frob a ‘widget’");
+static_assert(std::string_view(err::message_v<err::error_type<"plain">>) == "plain");
+
+using list = err::fmt_error_t<"Got {{{}}}", err::type_list_arg_v<widget, widget>>;
+static_assert(std::string_view(err::message_v<list>) == "Got {‘widget’, ‘widget’}");
+
+// Rendering an error renders each of its children beneath it
+using parent = err::fmt_errorex_t<leaf, "Failed to {}", cx_str{"go"}>;
+static_assert(std::string_view(err::render_error(parent{}))
+              == "Failed to go\n\n→ because:\n\n  Cannot frob a ‘widget’");
+
+// An interned message is named by its type, and its text is only looked up to render it
+struct frob_msg {
+    static constexpr cx_str text = "Cannot {} a {:'}";
+};
+static_assert(err::message_type<frob_msg>);
+static_assert(not err::message_type<widget>);
+
+using interned = err::msg_error_t<frob_msg, cx_str{"frob"}, err::type_arg_v<widget>>;
+static_assert(
+    std::same_as<interned,
+                 err::fmt_error_type<frob_msg, void, cx_str{"frob"}, err::type_arg_v<widget>>>);
+static_assert(std::string_view(err::message_v<interned>) == err::message_v<leaf>);
+
+using interned_parent
+    = err::msg_errorex_t<interned, frob_msg, cx_str{"see"}, err::type_arg_v<widget>>;
+static_assert(std::string_view(err::render_error(interned_parent{}))
+              == "Cannot see a ‘widget’\n\n→ because:\n\n  Cannot frob a ‘widget’");
+
+// An error may render another error as part of its message
+using wrapper = err::fmt_error_t<"[{}]", err::error_arg_v<leaf>>;
+static_assert(std::string_view(err::render_error(wrapper{})) == "[Cannot frob a ‘widget’]");
+
+}  // namespace
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "./constant_fold.hpp"
 #include "./context.hpp"
 #include "./define.hpp"
 #include "./error.hpp"
@@ -43,16 +44,23 @@ struct closure {
     NEO_NO_UNIQUE_ADDRESS BoundContext _bound;
 
     constexpr decltype(auto) operator()(auto&& x) const {
-        auto inner = _bound.bind(lmno::make_named<"α">(ast::nothing{}),  //
-                                 lmno::make_named<"ω">(NEO_FWD(x)));
+        auto inner = this->_layer(lmno::make_named<"α">(ast::nothing{}),  //
+                                  lmno::make_named<"ω">(NEO_FWD(x)));
         return invoke(evaluate, Code{}, _sema, inner);
     }
 
     constexpr decltype(auto) operator()(auto&& w, auto&& x) const {
-        auto inner = _bound.bind(lmno::make_named<"α">(NEO_FWD(w)),  //
-                                 lmno::make_named<"ω">(NEO_FWD(x)));
+        auto inner = this->_layer(lmno::make_named<"α">(NEO_FWD(w)),  //
+                                  lmno::make_named<"ω">(NEO_FWD(x)));
         return invoke(evaluate, Code{}, _sema, inner);
     }
+
+    // Bind α and ω over the captured context, which is referred to rather than copied
+    template <typename... Args>
+    constexpr auto _layer(Args&&... args) const noexcept {
+        auto local = scope<>{}.bind(NEO_FWD(args)...);
+        return layered_context<decltype(local), BoundContext>{NEO_MOVE(local), &_bound};
+    }
 };
 LMNO_AUTO_CTAD_GUIDE(closure);
 
@@ -60,10 +68,38 @@ template <typename Code, typename S, typename B>
 constexpr auto render::type_v<closure<Code, S, B>>
     = cx_fmt_v<"(closure {{{}}})", ast::render_v<Code>>;
 
+namespace msg {
+
+struct no_strand_reference {
+    static constexpr cx_str text
+        = "Cannot form a strand for {:'}: There is no common reference type between the "
+          "evaluated element types ({})";
+};
+
+}  // namespace msg
+
+namespace eval_detail {
+
+// Whether evaluation with the given checking stops at a value of type T, and returns it as the
+// result. Unchecked evaluation never asks whether T is an error.
+template <bool Checked, typename T>
+constexpr bool stops_at_v = false;
+
+template <typename T>
+constexpr bool stops_at_v<true, T> = any_error<T>;
+
+}  // namespace eval_detail
+
 /**
- * @brief The default language evaluator semantics
+ * @brief The language evaluator semantics
+ *
+ * @tparam Checked If `true`, the result of every subexpression is checked for errors, and an error
+ * is returned as the result as soon as it appears. Strands check their element types so they can
+ * explain why they cannot be formed. If `false`, none of these checks are instantiated. See
+ * default_sema and fast_sema.
  */
-struct default_sema {
+template <bool Checked>
+struct basic_sema {
     // A typed constant evaluates to itself
     template <typed_constant C>
     constexpr C evaluate(auto&&, C v) const noexcept {
@@ -83,11 +119,11 @@ struct default_sema {
         decltype(auto) left  = this->evaluate(context, Left{});
         decltype(auto) fn    = this->evaluate(context, Mid{});
         decltype(auto) right = this->evaluate(context, Right{});
-        if constexpr (LMNO_IS_ERROR(left)) {
+        if constexpr (eval_detail::stops_at_v<Checked, decltype(left)>) {
             return left;
-        } else if constexpr (LMNO_IS_ERROR(right)) {
+        } else if constexpr (eval_detail::stops_at_v<Checked, decltype(right)>) {
             return right;
-        } else if constexpr (LMNO_IS_ERROR(fn)) {
+        } else if constexpr (eval_detail::stops_at_v<Checked, decltype(fn)>) {
             return fn;
         } else {
             return invoke(NEO_FWD(fn), NEO_FWD(left), NEO_FWD(right));
@@ -105,9 +141,9 @@ struct default_sema {
     constexpr auto evaluate(const auto& context, ast::monad<Fn, Right>) const {
         decltype(auto) fn    = this->evaluate(context, Fn{});
         decltype(auto) right = this->evaluate(context, Right{});
-        if constexpr (LMNO_IS_ERROR(fn)) {
+        if constexpr (eval_detail::stops_at_v<Checked, decltype(fn)>) {
             return fn;
-        } else if constexpr (LMNO_IS_ERROR(right)) {
+        } else if constexpr (eval_detail::stops_at_v<Checked, decltype(right)>) {
             return right;
         } else {
             return invoke(NEO_FWD(fn), NEO_FWD(right));
@@ -117,9 +153,14 @@ struct default_sema {
     // Strand evaluation is a bit trickier:
     template <typename... Elems>
     constexpr decltype(auto) evaluate(const auto& context, ast::strand<Elems...> s) const {
-        // Capture the types of each element's evaluation:
-        using eval_type = meta::list<decltype(this->evaluate(context, Elems{}))...>;
-        return this->eval_strand(context, s, meta::ptr<eval_type>{});
+        if constexpr (Checked) {
+            // Capture the types of each element's evaluation:
+            using eval_type = meta::list<decltype(this->evaluate(context, Elems{}))...>;
+            return this->eval_strand(context, s, meta::ptr<eval_type>{});
+        } else {
+            return strand_range{strand_range_construct_tag_t{},
+                                this->evaluate(context, Elems{})...};
+        }
     }
 
     template <typename... Elems, typename... ElemEvals>
@@ -127,11 +168,9 @@ struct default_sema {
     eval_strand(const auto& context, ast::strand<Elems...>, meta::list<ElemEvals...>*) const {
         // Check that we will have a common reference
         if constexpr (not(neo::has_common_reference<unconst_t<ElemEvals>> and ...)) {
-            return err::make_error<
-                "Cannot form a strand for {:'}: There is no common reference type between the "
-                "evaluated element types ({})",
-                ast::render_v<ast::strand<Elems...>>,
-                cx_str_join_v<", ", cx_fmt_v<"{:'}", render::type_v<ElemEvals>...>>>();
+            return err::msg_error_t<msg::no_strand_reference,
+                                    ast::code_arg_v<ast::strand<Elems...>>,
+                                    err::type_list_arg_v<ElemEvals...>>{};
         } else {
             // Evaluate each element and construct the strand range:
             return strand_range{strand_range_construct_tag_t{},
@@ -139,11 +178,24 @@ struct default_sema {
         }
     }
 
-    // Evaluation of a function block generates a closure:
+    // The names from the enclosing scope that a block needs to capture. α and ω are always rebound
+    // when the closure is invoked, so an enclosing α or ω is never visible.
+    template <typename Code>
+    struct captures {
+        template <lex::token Name>
+        constexpr static bool test
+            = ast::uses_name_v<Name, Code> and Name != lex::token{"α"} and Name != lex::token{"ω"};
+    };
+
+    // Evaluation of a function block generates a closure, capturing only the names that it uses:
     template <typename Code, typename Ctx>
     constexpr auto evaluate(const Ctx& context, ast::block<Code>) const {
-        auto c = lmno::closure<Code, default_sema, Ctx>{*this, context};
-        return c;
+        if constexpr (requires { context.template only<captures<Code>>(); }) {
+            auto bound = context.template only<captures<Code>>();
+            return lmno::closure<Code, basic_sema, decltype(bound)>{*this, NEO_MOVE(bound)};
+        } else {
+            return lmno::closure<Code, basic_sema, Ctx>{*this, context};
+        }
     }
 
     // This one only handles the case of a lone assignment with no subsequent statements. The name
@@ -170,7 +222,7 @@ struct default_sema {
     constexpr auto evaluate_stmts(const auto& context, ast::stmt_seq<Head, Tail...>) const {
         // Case: Head is a non-assignment expression
         auto&& el = this->evaluate(context, Head{});
-        if constexpr (LMNO_IS_ERROR(el)) {
+        if constexpr (eval_detail::stops_at_v<Checked, decltype(el)>) {
             return el;
         } else {
             return this->evaluate_stmts(context, ast::stmt_seq<Tail...>{});
@@ -182,7 +234,7 @@ struct default_sema {
                                   ast::stmt_seq<ast::assignment<ID, RHS>, Peek, Tail...>) const {
         // Case: Head is an assignment expression
         auto&& value = this->evaluate(context, RHS{});
-        if constexpr (LMNO_IS_ERROR(value)) {
+        if constexpr (eval_detail::stops_at_v<Checked, decltype(value)>) {
             return value;
         } else {
             auto ctx = this->bind_assignment(context, ID{}, NEO_FWD(value));
@@ -190,16 +242,70 @@ struct default_sema {
         }
     }
 
+    // The new context only needs to live as long as the rest of the statement sequence, during
+    // which the current context is still alive, so it may refer to the values of the current
+    // context instead of copying them.
     template <lex::token Name>
-    constexpr decltype(auto)
-    bind_assignment(const auto& context, ast::name<Name>, auto&& value) const {
-        return context.bind(lmno::make_named<Name>(NEO_FWD(value)));
+    constexpr static decltype(auto)
+    bind_assignment(const auto& context, ast::name<Name>, auto&& value) {
+        if constexpr (requires { context.bind_borrowed(lmno::make_named<Name>(NEO_FWD(value))); }) {
+            return context.bind_borrowed(lmno::make_named<Name>(NEO_FWD(value)));
+        } else {
+            return context.bind(lmno::make_named<Name>(NEO_FWD(value)));
+        }
     }
 };
 
-template <typename Code>
-constexpr auto eval() -> invoke_t<evaluate_fn const&, Code, default_sema, default_context<>> {
-    return invoke(evaluate, Code{}, default_sema{}, default_context{});
+/**
+ * @brief The default language evaluator semantics, which checks for errors
+ */
+using default_sema = basic_sema<true>;
+
+/**
+ * @brief Evaluator semantics for code that is already known to be correct
+ *
+ * Evaluates the same as default_sema, but does not look for errors: Error values are not
+ * intercepted, and strands are formed without checking their element types. If the code is not
+ * valid, the result is an ill-formed program or an error value that does not explain where it came
+ * from. Use default_sema to find out why some code is not valid.
+ *
+ * Functions are still called with lmno::invoke, which only builds an error when an invocation
+ * fails, and shares its instantiations with constant folding and the standard library.
+ */
+using fast_sema = basic_sema<false>;
+
+/**
+ * @brief Whether eval() may fold the constant subexpressions of the code before evaluating it with
+ * Sema. The folder evaluates with default_sema and resolves names with define<>, so a semantics
+ * that gives names or nodes some other meaning must not be folded. Specialize this to opt in.
+ */
+template <typename Sema>
+constexpr bool folds_constants_v = false;
+
+template <bool Checked>
+constexpr bool folds_constants_v<basic_sema<Checked>> = true;
+
+namespace eval_detail {
+
+template <typename Code, typename Sema>
+auto fold_for() {
+    if constexpr (folds_constants_v<neo::remove_cvref_t<Sema>>) {
+        return constant_fold_t<Code>{};
+    } else {
+        return Code{};
+    }
+}
+
+}  // namespace eval_detail
+
+/// The code that eval() hands to Sema: Its constant subexpressions are folded if Sema allows it
+template <typename Code, typename Sema>
+using folded_for_t = decltype(eval_detail::fold_for<Code, Sema>());
+
+// Constant subexpressions are folded before evaluation. See const_folder.
+template <typename Code, typename Folded = constant_fold_t<Code>>
+constexpr auto eval() -> invoke_t<evaluate_fn const&, Folded, default_sema, default_context<>> {
+    return invoke(evaluate, Folded{}, default_sema{}, default_context{});
 }
 
 template <cx_str CodeStr, typename Parsed = parse_t<CodeStr>>
@@ -207,11 +313,23 @@ constexpr auto eval() -> decltype(eval<Parsed>()) {
     return eval<Parsed>();
 }
 
+// Evaluate with the given semantics instead of default_sema
+template <typename Code, typename Sema, typename Folded = folded_for_t<Code, Sema>>
+constexpr auto eval(Sema&& sema) -> invoke_t<evaluate_fn const&, Folded, Sema, default_context<>> {
+    return invoke(evaluate, Folded{}, NEO_FWD(sema), default_context{});
+}
+
+template <cx_str CodeStr, typename Sema, typename Parsed = parse_t<CodeStr>>
+constexpr auto eval(Sema&& sema) -> decltype(eval<Parsed>(NEO_FWD(sema))) {
+    return eval<Parsed>(NEO_FWD(sema));
+}
+
 template <cx_str CodeStr>
 constexpr auto eval_v = lmno::eval<CodeStr>();
 
 template <cx_str S, typename Sema = default_sema>
-using eval_t = decltype(NEO_DECLVAL(Sema).evaluate(default_context{}, parse_t<S>{}));
+using eval_t
+    = decltype(NEO_DECLVAL(Sema).evaluate(default_context{}, folded_for_t<parse_t<S>, Sema>{}));
 
 template <typename AST, typename Sema>
 using eval_ast_t = decltype(eval<AST>(NEO_DECLVAL(Sema)));
@@ -1,9 +1,19 @@
 #include "./eval.hpp"
 
+#include "./md/aplib.hpp"
 #include "./stdlib.hpp"
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 using lmno::Const;
 using lmno::ConstInt64;
 using lmno::eval;
@@ -55,6 +65,27 @@ static_assert(eval<"-φ:⌈˜:-">()(12, 8) == 4);
 // Fold
 static_assert(eval<"/:+∘⍳">()(6) == 15);
 static_assert(eval<"/:+∘⍳">()(Const<6>{}) == 15);
+// Fold over an over-each (sum of squares)
+constexpr auto one_two_three = std::array{1, 2, 3};
+static_assert(eval<"/:+∘¨:{ω×ω}">()(one_two_three) == 14);
+
+// Scanning an unbounded range is lazy
+static_assert(std::ranges::equal(eval<"5↑·\\:+·⍳∞">(), std::array{0, 1, 3, 6, 10}));
+static_assert(std::ranges::equal(eval<"2↓5↑·\\:+·⍳∞">(), std::array{3, 6, 10}));
+static_assert(std::ranges::equal(eval<"{3↑·¨:{ω×ω}ω}·\\:+·⍳∞">(), std::array{0, 1, 9}));
+static_assert(eval<"/:+$4↑·\\:+·⍳∞">() == 10);
+
+// Scanning into caller-provided storage
+constexpr bool check_scan_into() {
+    std::array<std::int64_t, 4> out{};
+    auto end = eval<"\\+">().into(out, std::array<std::int64_t, 3>{1, 2, 3});
+    return end == out.begin() + 3 and out == std::array<std::int64_t, 4>{1, 3, 6, 0};
+}
+static_assert(check_scan_into());
+
+// Parallel algorithms are sequential in constant evaluation
+static_assert(eval<"∥:/:+">()(one_two_three) == 6);
+static_assert(eval<"∥:/:+∘¨:{ω×ω}">()(one_two_three) == 14);
 static_assert(eval<"3⊸÷">()(4, 10) == rational{3, 10});
 
 // Concept checks
@@ -84,6 +115,43 @@ static_assert(
                       lmno::default_context<lmno::scope<lmno::named_value<"α", std::string>,
                                                         lmno::named_value<"ω", lmno::Const<0>>>>>>);
 
+// A closure captures only the names that its block uses
+using captures_b = lmno::eval_t<"a ← 1‿2‿3 ; b ← 4 ; c ← 5 ; {ω + b + {c} 0}">;
+static_assert(std::same_as<
+              decltype(captures_b::_bound),
+              lmno::default_context<lmno::scope<lmno::named_value<"b", lmno::ConstInt64<4>>,
+                                                lmno::named_value<"c", lmno::ConstInt64<5>>>>>);
+static_assert(lmno::stateless<lmno::eval_t<"a ← 1‿2‿3 ; {ω + 1}">>);
+
+// Trusted evaluation gives the same results as the default semantics
+static_assert(std::same_as<lmno::fast_sema, lmno::basic_sema<false>>);
+static_assert(lmno::stateless<lmno::fast_sema>);
+static_assert(lmno::folds_constants_v<lmno::fast_sema>);
+static_assert(std::same_as<lmno::eval_t<"4+3", lmno::fast_sema>, ConstInt64<7>>);
+static_assert(std::same_as<lmno::eval_t<"a ← 4 ; b ← 3 ; a÷b", lmno::fast_sema>,
+                           lmno::eval_t<"a ← 4 ; b ← 3 ; a÷b">>);
+static_assert(eval<"/:+∘¨:{ω×ω}">(lmno::fast_sema{})(one_two_three) == 14);
+static_assert(eval<"a ← 2 ; {ω + a}">(lmno::fast_sema{})(5) == 7);
+static_assert(std::ranges::equal(eval<"1‿2‿3">(lmno::fast_sema{}), one_two_three));
+static_assert(std::same_as<lmno::eval_ast_t<lmno::parse_t<"5 - 3">, lmno::fast_sema>,
+                           lmno::eval_t<"5 - 3">>);
+// ...but does not stop at an error that the default semantics would return
+static_assert(lmno::any_error<lmno::eval_t<"⌽ 5 ; 3">>);
+static_assert(std::same_as<lmno::eval_t<"⌽ 5 ; 3", lmno::fast_sema>, ConstInt64<3>>);
+
+// The code is only folded for the semantics that agree with the folder. Others see it as written
+struct ast_sema {
+    template <typename Code>
+    constexpr Code evaluate(const auto&, Code) const noexcept {
+        return {};
+    }
+};
+static_assert(not lmno::folds_constants_v<ast_sema>);
+static_assert(std::same_as<lmno::eval_t<"4+3", ast_sema>, lmno::parse_t<"4+3">>);
+static_assert(std::same_as<decltype(eval<"4+3">(ast_sema{})), lmno::parse_t<"4+3">>);
+static_assert(std::same_as<lmno::folded_for_t<lmno::parse_t<"4+3">, const lmno::fast_sema&>,
+                           lmno::constant_fold_t<lmno::parse_t<"4+3">>>);
+
 // Simply requires that its argument be a typed-constant of value V
 template <auto V, auto U>
     requires(V == U)
@@ -176,6 +244,11 @@ TEST_CASE("Cases") {
     lmno::any_error auto e [[maybe_unused]]  = eval<"/:+⟜⍳7">();
     lmno::any_error auto e1 [[maybe_unused]] = eval<"÷">()(std::string("yo"));
     lmno::any_error auto e2 [[maybe_unused]] = eval<"2⊸÷">()(std::string("yo"));
+    lmno::any_error auto e3 [[maybe_unused]] = eval<"⌽">()(5);
+    // The innermost error names the type that was given
+    static_assert(std::string_view(lmno::err::render_error(e3)).find(
+                      "Type ‘int’ is not a viewable-range")
+                  != std::string_view::npos);
 
     // Mapping:
     constexpr lmno::non_error auto add_four = eval<"¨{4+ω}">();
@@ -195,3 +268,122 @@ TEST_CASE("Cases") {
     // Attempt to "use" `result` to see the error message:
     // result.foo;
 }
+
+TEST_CASE("Parallel algorithms match sequential results") {
+    // Large enough to be split between threads
+    std::vector<std::int64_t> nums(1 << 18);
+    for (std::size_t i = 0; i < nums.size(); ++i) {
+        nums[i] = static_cast<std::int64_t>((i * 7919) % 1009) - 500;
+    }
+    CHECK(eval<"∥:/:+">()(nums) == eval<"/+">()(nums));
+    CHECK(eval<"∥:/:⌈">()(nums) == eval<"/⌈">()(nums));
+    CHECK(eval<"∥:/:+∘¨:{ω×ω}">()(nums) == eval<"/:+∘¨:{ω×ω}">()(nums));
+    CHECK(eval<"∥:/:+∘⍳">()(std::int64_t(1 << 18)) == eval<"/:+∘⍳">()(std::int64_t(1 << 18)));
+    CHECK(eval<"∥:\\:+">()(nums) == eval<"\\+">()(nums));
+
+    auto par_doubled = eval<"∥:¨:{2×ω}">()(nums);
+    auto seq_doubled = eval<"¨{2×ω}">()(nums);
+    CHECK(std::ranges::equal(par_doubled, seq_doubled.as_range()));
+
+    // Not associative: Falls back to the sequential implementation
+    CHECK(eval<"∥:/:-">()(nums) == eval<"/-">()(nums));
+}
+
+TEST_CASE("Parallel over-each of a predicate") {
+    // Not a multiple of the chunk count, and the results are bit-packed into a std::vector<bool>
+    std::vector<std::int64_t> nums((1 << 18) + 37);
+    for (std::size_t i = 0; i < nums.size(); ++i) {
+        nums[i] = static_cast<std::int64_t>((i * 7919) % 1009) - 500;
+    }
+    auto par_pos = eval<"∥:¨:{0<ω}">()(nums);
+    static_assert(std::same_as<decltype(par_pos), std::vector<bool>>);
+    auto seq_pos = eval<"¨{0<ω}">()(nums);
+    CHECK(std::ranges::equal(par_pos, seq_pos.as_range()));
+}
+
+TEST_CASE("Parallel chunks") {
+    namespace par = lmno::stdlib::par_detail;
+    std::vector<std::pair<std::size_t, std::size_t>> bounds(7);
+    par::fork_join(100'003, 7, [&](std::size_t c, std::size_t lo, std::size_t hi) {
+        bounds[c] = {lo, hi};
+    });
+    // The chunks cover every index, and each begins on a multiple of 64
+    CHECK(bounds.front().first == 0);
+    CHECK(bounds.back().second == 100'003);
+    for (std::size_t c = 0; c < bounds.size(); ++c) {
+        CHECK(bounds[c].first % 64 == 0);
+        if (c != 0) {
+            CHECK(bounds[c].first == bounds[c - 1].second);
+        }
+    }
+
+    // An exception in a worker thread is rethrown on the calling thread
+    std::atomic<int> finished{0};
+    auto             throw_in_last = [&](std::size_t c, std::size_t, std::size_t) {
+        if (c == 6) {
+            throw std::runtime_error("chunk failed");
+        }
+        ++finished;
+    };
+    CHECK_THROWS_AS(par::fork_join(100'003, 7, throw_in_last), std::runtime_error);
+    CHECK(finished == 6);
+}
+
+TEST_CASE("Scan into caller-provided storage") {
+    std::vector<std::int64_t> nums(1000);
+    std::iota(nums.begin(), nums.end(), std::int64_t(1));
+    auto scan = eval<"\\+">();
+
+    std::vector<std::int64_t> out(1000);
+    scan.into(out, nums);
+    CHECK(std::ranges::equal(out, scan(nums)));
+
+    // An md::mdvector is written through its zero-cells, in row-major order
+    lmno::md::mdvector_of_rank<std::int64_t, 2> md{lmno::md::uz_dextents<2>(2, 500)};
+    scan.into(md, std::int64_t(5), nums);
+    CHECK(md[{0, 0}] == 5 + 1);
+    CHECK(md[{0, 499}] == 5 + 500 * 501 / 2);
+    CHECK(md[{1, 499}] == 5 + 1000 * 1001 / 2);
+
+    std::vector<std::int64_t> too_small(10);
+    CHECK_THROWS(scan.into(too_small, nums));
+}
+
+// Counts how many times it has been copied
+struct copy_counter {
+    int* copies;
+
+    copy_counter(int* c)
+        : copies(c) {}
+    copy_counter(const copy_counter& o)
+        : copies(o.copies) {
+        ++*copies;
+    }
+    copy_counter(copy_counter&&)                 = default;
+    copy_counter& operator=(const copy_counter&) = default;
+};
+
+TEST_CASE("Statement sequences do not copy their bound values") {
+    int  copies = 0;
+    auto ctx    = lmno::default_context{}.bind(lmno::make_named<"big">(copy_counter{&copies}));
+    auto code   = lmno::parse_t<"a ← big ; b ← 1 ; c ← a ; d ← 2 ; e ← c ; e">{};
+    copy_counter result = lmno::evaluate(code, lmno::default_sema{}, ctx);
+    // Only the final result is copied out of the sequence
+    CHECK(copies == 1);
+    CHECK(result.copies == &copies);
+}
+
+TEST_CASE("Calling a closure does not copy its captured values") {
+    int  copies = 0;
+    auto ctx    = lmno::default_context{}.bind(lmno::make_named<"big">(copy_counter{&copies}));
+    auto f      = lmno::evaluate(lmno::parse_t<"{ω ⊣ big}">{}, lmno::default_sema{}, ctx);
+    // The closure captures its own copy of "big"
+    const int captured = copies;
+    CHECK(f(1) == 1);
+    CHECK(f(2, 3) == 3);
+    CHECK(copies == captured);
+    // A closure created within a call holds its own copies, since it may outlive the call
+    auto g = lmno::evaluate(lmno::parse_t<"{{big ⊢ α + ω}}">{}, lmno::default_sema{}, ctx);
+    auto h = g(4);
+    CHECK(h(5, 6) == 11);
+}
@@ -24,16 +24,57 @@ namespace invoke_detail {
 template <bool JustFalse>
 struct pick_invoker;
 
+// The result type of a well-formed invocation
+template <typename R>
+struct valid_invocation {
+    constexpr static bool is_valid = true;
+    using type                     = R;
+};
+
+struct invalid_invocation {
+    constexpr static bool is_valid = false;
+};
+
+template <typename F, typename... Args>
+auto try_invocation(int)
+    -> valid_invocation<decltype(neo::invoke(NEO_DECLVAL(F), NEO_DECLVAL(Args)...))>;
+
+template <typename...>
+auto try_invocation(...) -> invalid_invocation;
+
+/**
+ * @brief The plain invocation of F with Args, without any of the features of lmno::invoke.
+ *
+ * This is a class template so that the invocation is only checked once for each combination of F
+ * and Args, no matter how many of the traits below ask about it.
+ */
+template <typename F, typename... Args>
+struct invocation : decltype(try_invocation<F, Args...>(0)) {};
+
 template <typename F, typename... Args>
 concept check_invocable_without_error =  //
     requires {
-        requires neo::invocable2<unconst_t<F>, Args...>;
-        requires non_error<neo::invoke_result_t<unconst_t<F>, Args...>>;
+        requires invocation<unconst_t<F>, Args...>::is_valid;
+        requires non_error<typename invocation<unconst_t<F>, Args...>::type>;
     };
 
+// The invoker that was picked for an invocation, and the type of its result
+template <typename Invoker, typename R>
+struct resolution {
+    using invoker = Invoker;
+    using type    = R;
+};
+
+/**
+ * @brief The resolution of lmno::invoke for F and Args.
+ *
+ * Everything that lmno::invoke needs is derived here, once for each combination of F and Args.
+ * Whether the invocation is noexcept is only worked out if someone asks.
+ */
 template <typename F, typename... Args>
-using pick_invoker2_t
-    = pick_invoker<check_invocable_without_error<F, Args...>>::template f<F, Args...>;
+struct resolved : pick_invoker<check_invocable_without_error<F, Args...>>::template f<F, Args...> {
+    constexpr static bool is_nothrow = resolved::invoker::template is_nothrow_v<F, Args...>;
+};
 
 }  // namespace invoke_detail
 
@@ -51,13 +92,9 @@ using pick_invoker2_t
  * @param args The arguments to apply to the invocable object
  */
 inline constexpr struct invoke_fn {
-    template <typename F,
-              typename... Args,
-              typename Invoker = invoke_detail::pick_invoker2_t<F, Args...>>
-    constexpr typename Invoker::template result_t<F, Args...> operator()(F&& fn,
-                                                                         Args&&... args) const
-        noexcept(Invoker::template is_nothrow_v<F, Args...>) {
-        return Invoker::invoke(static_cast<F&&>(fn), static_cast<Args&&>(args)...);
+    template <typename F, typename... Args, typename R = invoke_detail::resolved<F, Args...>>
+    constexpr typename R::type operator()(F&& fn, Args&&... args) const noexcept(R::is_nothrow) {
+        return R::invoker::invoke(static_cast<F&&>(fn), static_cast<Args&&>(args)...);
     }
 } invoke;
 
@@ -155,15 +192,15 @@ explicit invoke_indirect(F&&) -> invoke_indirect<F>;
  */
 #define LMNO_INDIRECT_INVOCABLE(ThisType)                                                          \
     template <typename... Args, typename This = ThisType&>                                         \
-    constexpr auto operator()(Args&&... args)                                       /**/           \
-        noexcept(::lmno::nothrow_invocable<::lmno::invoke_indirect<This>, Args...>) /**/           \
+    constexpr auto operator()(Args&&... args) noexcept(                                            \
+        ::lmno::invoke_detail::resolved<::lmno::invoke_indirect<This>, Args...>::is_nothrow)       \
     {                                                                                              \
         return ::lmno::invoke(::lmno::invoke_indirect{*this}, NEO_FWD(args)...);                   \
     }                                                                                              \
                                                                                                    \
     template <typename... Args, typename This = ThisType const&>                                   \
-    constexpr auto operator()(Args&&... args) const                                 /**/           \
-        noexcept(::lmno::nothrow_invocable<::lmno::invoke_indirect<This>, Args...>) /**/           \
+    constexpr auto operator()(Args&&... args) const noexcept(                                      \
+        ::lmno::invoke_detail::resolved<::lmno::invoke_indirect<This>, Args...>::is_nothrow)       \
     {                                                                                              \
         return ::lmno::invoke(::lmno::invoke_indirect{*this}, NEO_FWD(args)...);                   \
     }                                                                                              \
@@ -202,15 +239,19 @@ struct unconst_arg<true> {
  */
 template <typename... Cast>
 struct basic_invoker {
-    /// Calculate the result type
+    /// The underlying invocation
     template <typename F, typename... Args>
-    using result_t = neo::invoke_result_t<
+    using invocation_t = invocation<
         // We unconditionally strip const from the invocable, since it can never
         // effect the result.
         unconst_t<F>,
         // Apply the caster to each argument
         apply_f<Cast, Args>...>;
 
+    /// Calculate the result type
+    template <typename F, typename... Args>
+    using result_t = typename invocation_t<F, Args...>::type;
+
     template <typename F, typename... Args>
     constexpr static bool is_nothrow_v
         = noexcept(neo::invoke(NEO_DECLVAL(unconst_t<F>), NEO_DECLVAL(apply_f<Cast, Args>)...));
@@ -227,48 +268,63 @@ struct basic_invoker {
 /**
  * @brief Special invoker that is selected if the return value can be placed in
  * an lmno::Const<> typed-constant for returning to the caller.
+ *
+ * @tparam Result The Const<> of the result, which was evaluated when the invoker was picked.
  */
-template <typename... Cast>
+template <typename Result>
 struct const_wrapping_invoker {
-    using base = basic_invoker<Cast...>;
-
-    template <typename F, typename... Args>
-    using result_t = Const<base::invoke(remove_cvref_t<F>{}, remove_cvref_t<Args>{}...)>;
-
     // Evaluation is constexpr and happens at compile time, so it never throws
     template <typename...>
     constexpr static bool is_nothrow_v = true;
 
-    template <typename F, typename... Args>
-    constexpr static result_t<F, Args...> invoke(const F&, const Args&...) noexcept {
+    template <typename... Ts>
+    constexpr static Result invoke(const Ts&...) noexcept {
         return {};
     }
 };
 
+// The messages of the errors generated by invoke()
+namespace msg {
+
+struct not_invocable {
+    static constexpr cx_str text
+        = "Object of type {:'} is not invocable with the given arguments {{{:}}}";
+};
+
+struct invocation_failed {
+    static constexpr cx_str text
+        = "Invocation of an object of type {:'} with arguments of type {{{:}}} failed";
+};
+
+struct banner {
+    static constexpr cx_str text
+        = "\n\n↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓\n"
+          "\n"
+          "{}\n\n"
+          "↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑\n\n";
+};
+
+}  // namespace msg
+
 /**
  * @brief An error-handling invoker that handles the case that no invocation
  * satisfies the constraints of the invocable object.
  */
 struct uninvocable {
-    template <typename...>
-    constexpr static bool is_nothrow_v = true;
-
     template <typename F, typename... Args>
     static constexpr auto make_error() {
         if constexpr (has_error_detail<F, Args...>) {
             using explained = invoke_error_t<F, Args...>;
-            constexpr auto M
-                = cx_fmt_v<"Object of type {:'} is not invocable with the given arguments {{{:}}}",
-                           render::type_v<F>,
-                           cx_str_join_v<", ", cx_fmt_v<"{:'}", render::type_v<Args>>...>>;
-            return err::error_type<M, explained>{};
-        } else if constexpr (neo::invocable2<F, Args...>) {
-            using E = neo::invoke_result_t<F, Args...>;
-            constexpr auto M
-                = cx_fmt_v<"Object of type {:'} is not invocable with the given arguments {{{:}}}",
-                           render::type_v<F>,
-                           cx_str_join_v<", ", cx_fmt_v<"{:'}", render::type_v<Args>>...>>;
-            return err::error_type<M, E>{};
+            return err::msg_errorex_t<explained,
+                                      msg::not_invocable,
+                                      err::type_arg_v<F>,
+                                      err::type_list_arg_v<Args...>>{};
+        } else if constexpr (invocation<F, Args...>::is_valid) {
+            using E = typename invocation<F, Args...>::type;
+            return err::msg_errorex_t<E,
+                                      msg::not_invocable,
+                                      err::type_arg_v<F>,
+                                      err::type_list_arg_v<Args...>>{};
         }
     }
 
@@ -282,18 +338,6 @@ struct uninvocable {
     }
 };
 
-template <cx_str M>
-constexpr auto render_error(err::error_type<M, void>) {
-    return M;
-}
-
-template <cx_str M, any_error Inner>
-constexpr auto render_error(err::error_type<M, Inner>) {
-    constexpr auto next   = render_error(Inner{});
-    constexpr auto indent = cx_str_replace<next, cx_str{"\n"}, cx_str{"\n  "}>();
-    return cx_fmt_v<"{}\n\n→ because:\n\n  {}", M, indent>;
-}
-
 template <typename Invoker>
 struct error_renderer {
     template <typename...>
@@ -302,18 +346,12 @@ struct error_renderer {
     template <typename F, typename... Args>
     static constexpr auto make_error() {
         using inner_error = typename Invoker::template result_t<F, Args...>;
-        constexpr auto M
-            = cx_fmt_v<"Invocation of an object of type {:'} with arguments of type {{{:}}} failed",
-                       render::type_v<F>,
-                       cx_str_join_v<", ", cx_fmt_v<"{:'}", render::type_v<Args>>...>>;
-        using top                         = err::error_type<M, inner_error>;
-        constexpr auto E [[maybe_unused]] = cx_fmt_v<
-            "\n\n↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓↓\n"
-            "\n"
-            "{}\n\n"
-            "↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑↑\n\n",
-            render_error(top{})>;
-        return err::error_type<E>{};
+        using top         = err::msg_errorex_t<inner_error,
+                                           msg::invocation_failed,
+                                           err::type_arg_v<F>,
+                                           err::type_list_arg_v<Args...>>;
+        // The whole chain of errors is only rendered into this message if someone asks for it
+        return err::msg_error_t<msg::banner, err::error_arg_v<top>>{};
     }
 
     template <typename F, typename... Args>
@@ -378,7 +416,8 @@ struct pick_invoker<true> {
 template <std::size_t Stop, typename Seq, typename F, typename... Args>
 struct find_cast_combo<Stop, Stop, Seq, F, Args...> {  // Stop condition
     template <typename, typename...>
-    using f = error_renderer<uninvocable>;
+    using f = resolution<error_renderer<uninvocable>,  //
+                         error_renderer<uninvocable>::result_t<F, Args...>>;
 };
 
 template <std::size_t Stop, std::size_t Mask, auto... Bits, typename F, typename... Args>
@@ -397,34 +436,43 @@ struct find_cast_combo {
     using f = find_cast_combo<Stop, Mask + 1, Seq, F, Args...>::template f<F, Args...>;
 };
 
+// The Const<> of the result of the invocation, or void if it is not a constant expression
 template <typename I, typename F, typename... Args>
-concept is_constexpr_invocation =  //
-    requires { typename lmno::Const<I::invoke(remove_cvref_t<F>{}, remove_cvref_t<Args>{}...)>; };
+auto const_result(int)
+    -> lmno::Const<I::invoke(remove_cvref_t<F>{}, remove_cvref_t<Args>{}...)>;
+
+template <typename...>
+void const_result(...);
 
 template <typename... Cast>
 struct pick_invoker_with_casts {
     template <typename F, typename... Args>
     static auto pick() {
         using basic = basic_invoker<Cast...>;
-        using Ret   = basic::template result_t<F, Args...>;
+        using inv   = basic::template invocation_t<F, Args...>;
+        using Ret   = inv::type;
+        using plain = resolution<basic, Ret>;
         if constexpr (stateless<Ret> or not structural<Ret> or not stateless<remove_cvref_t<F>>
                       or not(stateless<remove_cvref_t<Args>> and ...)) {
             // Return type is stateless (we don't want to double-wrap)
             // OR: not-structural, so we can't put the value in an NTTP
             // OR: The function/arguments aren't stateless, so we can't default-init them and be
             // certain we'll get the same result on invocation.
-            return basic{};
-        } else if constexpr (not is_constexpr_invocation<basic, F, Args...>) {
-            // The invocation itself is not a constant expression, so we can't
-            // get a constexpr value to place in an NTTP
-            return basic{};
+            return plain{};
         } else {
-            // It qualifies: Wrap the result in a Const<>:
-            return const_wrapping_invoker<Cast...>{};
+            // Evaluate the invocation once, here. If it is not a constant expression, we can't
+            // get a constexpr value to place in an NTTP
+            using Wrapped = decltype(const_result<basic, F, Args...>(0));
+            if constexpr (std::same_as<Wrapped, void>) {
+                return plain{};
+            } else {
+                // It qualifies: Wrap the result in a Const<>:
+                return resolution<const_wrapping_invoker<Wrapped>, Wrapped>{};
+            }
         }
     }
 
-    // Select an invoker based on the return type
+    // Select an invoker based on the return type, as a resolution<>
     template <typename F, typename... Args>
     using f = decltype(pick<F, Args...>());
 };
@@ -31,6 +31,15 @@ static_assert(std::same_as<lmno::invoke_t<std::plus<>, Const<4>, Const<3>>, Cons
 static_assert(std::same_as<lmno::invoke_t<std::divides<>, Const<rational{4}>&&, Const<3>>,
                            Const<rational{4, 3}>>);
 
+// Each invocation is resolved once, to an invoker and its result type
+using plus_ints = invoke_detail::resolved<std::plus<>, int, int>;
+static_assert(std::same_as<plus_ints::type, int>);
+static_assert(plus_ints::is_nothrow);
+using plus_consts = invoke_detail::resolved<std::plus<>, Const<2>, Const<5>>;
+static_assert(std::same_as<plus_consts::type, Const<7>>);
+static_assert(plus_consts::is_nothrow);
+static_assert(any_error<invoke_detail::resolved<std::plus<>, int, widget>::type>);
+
 template <typename T>
 struct add {
     T rhs;
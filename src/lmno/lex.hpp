@@ -10,7 +10,11 @@
 
 namespace lmno::lex {
 
-constexpr static std::size_t max_token_length = 23;
+/**
+ * The longest token that can be stored in a token. Tokens are only materialized for names, and
+ * trailing nul chars do not appear in mangled names, so this can be generous.
+ */
+constexpr static std::size_t max_token_length = 63;
 
 /**
  * @brief Represents a LMNO token.
@@ -47,8 +51,51 @@ struct token {
 template <token... Tokens>
 struct token_list;
 
-constexpr bool is_digit(char c) { return c <= '9' and c >= '0'; }
-constexpr bool is_alpha(char c) { return (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z'); }
+namespace detail {
+
+/// The classes of the first char of a token
+enum class char_class : std::uint8_t {
+    end,
+    space,
+    digit,
+    alpha,
+    // Any other ASCII char
+    other,
+    // The first byte of a two, three, or four-byte UTF-8 sequence
+    lead2,
+    lead3,
+    lead4,
+};
+
+constexpr auto char_classes = [] {
+    std::array<char_class, 256> ret = {};
+    for (int c = 1; c < 256; ++c) {
+        ret[c] = c < 0x80 ? char_class::other
+            : c < 0xc0    ? char_class::lead4  // Stray continuation bytes are treated as four bytes
+            : c < 0xe0    ? char_class::lead2
+            : c < 0xf0    ? char_class::lead3
+                          : char_class::lead4;
+    }
+    ret[' ']  = char_class::space;
+    ret['\n'] = char_class::space;
+    for (int c = '0'; c <= '9'; ++c) {
+        ret[c] = char_class::digit;
+    }
+    for (int c = 'a'; c <= 'z'; ++c) {
+        ret[c]            = char_class::alpha;
+        ret[c - 'a' + 'A'] = char_class::alpha;
+    }
+    return ret;
+}();
+
+constexpr char_class classify(char c) noexcept {
+    return char_classes[static_cast<std::uint8_t>(c)];
+}
+
+}  // namespace detail
+
+constexpr bool is_digit(char c) { return detail::classify(c) == detail::char_class::digit; }
+constexpr bool is_alpha(char c) { return detail::classify(c) == detail::char_class::alpha; }
 constexpr bool is_ident(char c) { return is_alpha(c) or is_digit(c); }
 
 namespace detail {
@@ -56,6 +103,7 @@ namespace detail {
 using meta::list;
 
 constexpr auto fin_token(const char* s, std::size_t len) {
+    assert(len <= max_token_length);
     token ret;
     for (auto i = 0u; i < len; ++i) {
         ret._chars[i] = s[i];
@@ -71,7 +119,7 @@ struct token_range {
     /// The beginning offset of the token
     std::uint32_t pos;
     /// The length of the token (in char)
-    std::uint8_t len;
+    std::uint32_t len;
 };
 
 /**
@@ -81,87 +129,62 @@ struct token_range {
  * @param begin_pos The offset within the string to begin searching for another token
  * @return constexpr token_range
  */
-constexpr token_range next_token(const char* const begin, std::uint32_t start_pos) {
-    auto it = begin + start_pos;
-    // The beginning index of the token within the string view:
-    std::uint32_t pos = start_pos;
-    // Skip leading whitespace
-    while (*it == ' ' or *it == '\n') {
-        ++it;
-        ++pos;
-    }
-
-    const char first = *it;
-    if (first & 0b1000'0000) {
-        if (*it) {
-            auto b = static_cast<std::uint8_t>(first);
-            switch ((b >> 4) & 0xf) {
-            case 0b1100:
-                if (it[1] == char(0xaf) and it[0] == char(0xc2)) {
-                    // A leading hi-bar '¯', which introduces a negative literal
-                    token_range peek = next_token(begin, pos + 2);
-                    peek.pos         = pos;
-                    peek.len += 2;
-                    return peek;
-                }
-                [[fallthrough]];
-            case 0b1101:
-                return {pos, 2};
-            case 0b1110:
-                return {pos, 3};
-            default:
-                return {pos, 4};
+constexpr token_range next_token(const char* const begin, std::uint32_t pos) {
+    // Skip leading whitespace and comments
+    while (true) {
+        if (classify(begin[pos]) == char_class::space) {
+            ++pos;
+        } else if (begin[pos] == '(' and begin[pos + 1] == ':') {
+            pos += 2;
+            while (begin[pos] and (begin[pos] != ':' or begin[pos + 1] != ')')) {
+                ++pos;
+            }
+            if (not begin[pos]) {
+                throw "Unterminated comment in source string";
             }
+            pos += 2;
+        } else {
+            break;
         }
     }
 
-    // Regular ASCII char
-    if (first >= 'A') {
-        if (is_ident(first)) {
-            // Ident
-            ++it;
-            std::uint8_t len = 1;
-            while (is_ident(*it)) {
-                ++it;
-                ++len;
-            }
-            return {pos, len};
-        } else {
-            return {pos, 1};
+    // The beginning index of the token within the string:
+    const std::uint32_t start = pos;
+    if (begin[pos] == char(0xc2) and begin[pos + 1] == char(0xaf)) {
+        // A leading hi-bar '¯', which introduces a negative literal. It joins the token that
+        // immediately follows it.
+        pos += 2;
+    }
+
+    switch (classify(begin[pos])) {
+    case char_class::end:
+    case char_class::space:
+        // End of input, or a lone hi-bar
+        break;
+    case char_class::digit:
+        while (is_digit(begin[pos])) {
+            ++pos;
         }
-    } else {
-        if (is_digit(first)) {
-            auto num_begin = it;
-            ++it;
-            while (is_digit(*it)) {
-                ++it;
-            }
-            auto len = static_cast<std::uint8_t>(it - num_begin);
-            return {pos, len};
-        } else {
-            // End case: Return an EOF
-            if (not *it) {
-                return {pos, 0};
-            }
-            if (first == '(' and it[1] == ':') {
-                // We're in a comment
-                it += 2;
-                pos += 2;
-                while (*it and (it[0] != ':' or it[1] != ')')) {
-                    ++it;
-                    ++pos;
-                }
-                if (not *it) {
-                    throw "Unterminated comment in source string";
-                }
-                it += 2;
-                pos += 2;
-                return next_token(begin, pos);
-            }
-            // Other:
-            return {pos, 1};
+        break;
+    case char_class::alpha:
+        while (is_ident(begin[pos])) {
+            ++pos;
         }
+        break;
+    case char_class::other:
+        pos += 1;
+        break;
+    case char_class::lead2:
+        pos += 2;
+        break;
+    case char_class::lead3:
+        pos += 3;
+        break;
+    case char_class::lead4:
+        pos += 4;
+        break;
     }
+    return {start, pos - start};
 }
 
 template <std::size_t N>
@@ -195,6 +218,20 @@ constexpr token take_token(const char* str_begin, token_range const& r) {
     return detail::fin_token(str_begin + r.pos, r.len);
 }
 
+/**
+ * @brief The ranges of each token in String, followed by the empty range that marks the end of the
+ * input. The array is exactly sized, so it is cheap to use as a template argument.
+ */
+template <cx_str String>
+constexpr auto token_ranges_v = [] {
+    constexpr auto res = tokenize<String.size() + 1>(String.data());
+    std::array<token_range, res.num_tokens + 1> ret = {};
+    for (std::size_t i = 0; i < ret.size(); ++i) {
+        ret[i] = res.tokens[i];
+    }
+    return ret;
+}();
+
 template <cx_str String, tokenize_result Result, std::size_t... I>
 auto prune_f(std::index_sequence<I...>*)
     -> token_list<take_token(String.data(), Result.tokens[I])...>;
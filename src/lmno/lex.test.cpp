@@ -29,6 +29,16 @@ static_assert(std::same_as<lex::tokenize_t<"foo(:I am a comment (with nested par
 
 static_assert(std::same_as<lex::tokenize_t<"2⊸^">, token_list<"2", "⊸", "^">>);
 
+// Consecutive comments, and a comment at the very end
+static_assert(std::same_as<lex::tokenize_t<"foo (:a:)(:b:) bar (:c:)">, token_list<"foo", "bar">>);
+
+// A hi-bar joins the token that immediately follows it
+static_assert(std::same_as<lex::tokenize_t<"1‿¯23 ¯">, token_list<"1", "‿", "¯23", "¯">>);
+
+// Names longer than 23 chars
+static_assert(std::same_as<lex::tokenize_t<"aVeryLongNameThatDoesNotFitIn23Chars+1">,
+                           token_list<"aVeryLongNameThatDoesNotFitIn23Chars", "+", "1">>);
+
 using big1 [[maybe_unused]] = lex::tokenize_t<
     "÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞"
     "·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞··÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷√π∞··÷√π∞·÷√π∞·÷√π∞·÷√π∞·÷"
@@ -3,6 +3,13 @@
 #include "./ast.hpp"
 #include "./lex.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <utility>
+
 // Expands to "typename", because I'm lazy
 #define tn typename
 
@@ -27,6 +34,8 @@ enum ikind {
     k_strand,
     k_int,
     k_nothing,
+    // Opens a block. The value is the span of the block's code (see encode_span())
+    k_block_begin,
 };
 
 // A node in the tree construction
@@ -37,6 +46,25 @@ struct node {
     u64 n;
 };
 
+// Convert an integer token into the std::int64_t value
+constexpr std::int64_t parse_int(std::string_view sv) {
+    int fac = 1;
+    if (sv.starts_with("¯")) {
+        fac = -1;
+        sv  = sv.substr(2);  // drop two bytes for the prefix
+    }
+    std::int64_t ret = 0;
+    for (auto it = sv.begin(); it != sv.end(); ++it) {
+        const int digit = *it - '0';
+        if (ret > (std::numeric_limits<std::int64_t>::max() - digit) / 10) {
+            throw "Integer literal is too large";
+        }
+        ret *= 10;
+        ret += digit;
+    }
+    return ret * fac;
+}
+
 // Takes a list of expression nodes and collapse into a single prefix/infix expression
 // NOTE that the node list comes from the expression stack, which is in reverse order.
 template <tn Nodes>
@@ -66,103 +94,154 @@ struct collapse_chain<list<X>> {
     using type = X;
 };
 
-// Convert the array of node instructions into the AST node tree
-template <auto Tokens>
+// The nodes for names and integers refer to their token by its range within the source code, packed
+// into the node's operand:
+constexpr u64 encode_span(const lex::detail::token_range& r) noexcept {
+    return (u64(r.pos) << 32) | r.len;
+}
+
+constexpr lex::detail::token_range decode_span(u64 span) noexcept {
+    return {static_cast<std::uint32_t>(span >> 32), static_cast<std::uint32_t>(span)};
+}
+
+// Find the k_block that closes the k_block_begin at `idx`
+constexpr u64 block_end(const auto& nodes, u64 idx) noexcept {
+    int depth = 0;
+    for (;; ++idx) {
+        if (nodes[idx].kind == k_block_begin) {
+            ++depth;
+        } else if (nodes[idx].kind == k_block and --depth == 0) {
+            return idx;
+        }
+    }
+}
+
+// The code within the encoded span of a string
+template <cx_str Code, u64 Span, auto Range = decode_span(Span)>
+constexpr auto code_span_v = cx_str<Range.len>(std::string_view(Code).substr(Range.pos, Range.len));
+
+// The nodes of the block opened at Nodes[Idx], as if the block's code had been parsed on its own
+template <auto Nodes, u64 Idx, u64 End = block_end(Nodes, Idx)>
+constexpr auto block_nodes_v = [] {
+    // Spans are made relative to the beginning of the block's code
+    const u64                   offset = u64(decode_span(Nodes[Idx].n).pos) << 32;
+    std::array<node, End - Idx> ret    = {};
+    for (u64 i = Idx + 1; i < End; ++i) {
+        node n = Nodes[i];
+        if (n.kind == k_name or n.kind == k_int or n.kind == k_block_begin) {
+            n.n -= offset;
+        }
+        ret[i - Idx - 1] = n;
+    }
+    ret.back() = {k_done, 0};
+    return ret;
+}();
+
+// The source code that is being parsed. Passed to the executor as a type, which is cheaper to use as
+// a template argument than the string itself.
+template <cx_str Code>
+struct source {
+    // Get the token at the given encoded range of the code
+    constexpr static token token_at(u64 span) noexcept {
+        return lex::detail::take_token(Code.data(), decode_span(span));
+    }
+
+    // The code within the given encoded span
+    template <u64 Span>
+    using sub = source<code_span_v<Code, Span>>;
+};
+
+// The state of the executor between nodes: The stack of ast:: nodes that we are building
+template <tn Stack>
+struct exec_state {
+    using stack = Stack;
+};
+
+// The nodes that the executor runs. Passed to the executor as a type, for the same reason as
+// source<>.
+template <auto Nodes>
+struct exec_nodes {
+    // The indices of the nodes that are run, in order, and the number of them. The nodes of a
+    // block are executed on their own (see the operator>> for a k_block_begin node), and are
+    // skipped here.
+    constexpr static auto order = [] {
+        std::array<u64, Nodes.size()> ret   = {};
+        u64                           count = 0;
+        for (u64 i = 0; Nodes[i].kind != k_done; ++i) {
+            ret[count++] = i;
+            if (Nodes[i].kind == k_block_begin) {
+                i = block_end(Nodes, i);
+            }
+        }
+        return std::pair{ret, count};
+    }();
+
+    // The index into Nodes of the Nth node that is run
+    constexpr static u64 index(u64 n) noexcept { return order.first[n]; }
+
+    // The Nth node that is run
+    constexpr static node at(u64 n) noexcept { return Nodes[index(n)]; }
+
+    // The number of nodes that are run
+    constexpr static u64 count = order.second;
+
+    // The nodes of the block that begins at the Nth node that is run
+    template <u64 N>
+    using block = exec_nodes<block_nodes_v<Nodes, index(N)>>;
+};
+
+// A run of `Count` nodes for the executor, beginning at the Begin'th node that Ns runs
+template <tn Src, tn Ns, u64 Begin, u64 Count>
+struct exec_run {};
+
+// Convert the array of node instructions into the AST node tree. Tokens are taken directly from the
+// source code, rather than from an array of tokens, to keep the template arguments small.
 struct executor {
     // The unused "void" is to work around unimplemented CWG 727 fixes.
     template <ikind K, tn = void>
     struct step;
 
-    template <ikind K, tn = void>
-    struct parse;
-
     /**
      * @brief Run the parse:
      *
-     * @tparam Nodes The array of nodes that will be used to construct the tree
-     * @tparam Idx The index into the array of nodes to execute. Begins at zero
-     * @tparam Stack An accumulator of ast:: nodes that we are building. When finished, should have
-     * one element.
+     * @tparam Src The source<> of the code that is being parsed
+     * @tparam Ns The exec_nodes<> of the nodes that will be used to construct the tree
+     *
+     * The nodes are applied to the stack of ast:: nodes one after another with a fold expression
+     * (see exec_run), so that no template recurses once per node. When finished, the stack should
+     * have one element.
      */
-    template <auto Nodes, u64 Idx = 0, tn Stack = list<>>
-    using exec_parse_t = parse<Nodes[Idx].kind, void>::template f<Nodes, Idx, Stack>;
-
-    template <tn Void>
-    struct parse<k_done, Void> {
-        // Final state: Return the one node:
-        template <auto, auto, tn Stack>
-        using f = head<Stack>;
-    };
-
-    template <ikind K, tn Void>
-    struct parse {
-        // Get the step based on the kind of the node:
-        using MyStep = step<K>;
-        // Recursive case:
-        template <auto Nodes,
-                  auto Idx,
-                  // The stack that we receive:
-                  tn StackIn,
-                  // Apply the step function to the node and receive the transformed
-                  // stack:
-                  tn StackOut = MyStep::template f<Nodes[Idx].n, StackIn>>
-        // Recurse into the parser, to the next node instruction, with the new stack:
-        using f = exec_parse_t<Nodes, Idx + 1, StackOut>;
-    };
+    template <tn Src, tn Ns>
+    using exec_parse_t
+        = head<tn decltype(exec_state<list<>>{} >> exec_run<Src, Ns, 0, Ns::count>{})::stack>;
 
     // A "·" node:
     template <tn Void>
     struct step<k_nothing, Void> {
-        template <u64, tn Stack>
+        template <tn, u64, tn Stack>
         using f = meta::push_front<Stack, nothing>;
     };
 
     // An integer literal:
     template <tn Void>
     struct step<k_int, Void> {
-        // Convert an integer token into the std::int64_t value
-        constexpr static std::int64_t parse_int(std::string_view sv) {
-            int fac = 1;
-            if (sv.starts_with("¯")) {
-                fac = -1;
-                sv  = sv.substr(2);  // drop two bytes for the prefix
-            }
-            std::int64_t ret = 0;
-            for (auto it = sv.begin(); it != sv.end(); ++it) {
-                ret *= 10;
-                ret += *it - '0';
-            }
-            return ret * fac;
-        }
-
-        // Parse the Nth token as an integer:
-        template <u64 N, tn Stack>
-        using f = meta::push_front<Stack, Const<parse_int(std::string_view(Tokens[N]))>>;
+        // Parse the token at span N as an integer:
+        template <tn Src, u64 N, tn Stack>
+        using f = meta::push_front<Stack, Const<parse_int(Src::token_at(N))>>;
     };
 
     template <tn Void>
     struct step<k_name, Void> {
-        // Bind the Nth token as a name:
-        template <u64 N, tn Stack>
-        using f = meta::push_front<Stack, name<Tokens[N]>>;
-    };
-
-    template <tn Void>
-    struct step<k_block, Void> {
-        // Wrap the top AST node in an ast::block
-        template <u64,
-                  tn Stack,
-                  tn Head   = head<Stack>,
-                  tn Blk    = block<Head>,
-                  tn Tail   = tail<Stack>,
-                  tn Stack2 = push_front<Tail, Blk>>
-        using f = Stack2;
+        // Bind the token at span N as a name:
+        template <tn Src, u64 N, tn Stack>
+        using f = meta::push_front<Stack, name<Src::token_at(N)>>;
     };
 
     template <tn Void>
     struct step<k_train, Void> {
         // Collapse the prior 'Count' nodes into a single prefix/infix node:
-        template <u64 Count,
+        template <tn,
+                  u64 Count,
                   tn  Stack,
                   tn  Split = split_at<Stack, Count>,
                   tn  Head  = head<Split>,
@@ -174,7 +253,8 @@ struct executor {
     template <tn Void>
     struct step<k_strand, Void> {
         // Collapse the prior 'Count' nodes into a strand node:
-        template <u64 Count,
+        template <tn,
+                  u64 Count,
                   tn  Stack,
                   tn  Split = split_at<Stack, Count>,
                   tn  Head  = head<Split>,
@@ -186,7 +266,8 @@ struct executor {
     template <tn Void>
     struct step<k_assign, Void> {
         // Create an assignment from the prior two nodes:
-        template <u64,
+        template <tn,
+                  u64,
                   tn Stack,
                   tn Val = head<Stack>,
                   tn ID  = second<Stack>,
@@ -197,7 +278,8 @@ struct executor {
     template <tn Void>
     struct step<k_seq, Void> {
         // Wrap the prior 'Count' nodes in an ast::stmt_seq
-        template <u64 Count,
+        template <tn,
+                  u64 Count,
                   tn  Stack,
                   tn  Split = split_at<Stack, Count>,
                   tn  Head  = head<Split>,
@@ -207,23 +289,78 @@ struct executor {
     };
 };
 
+// The number of nodes in each of the (at most) 16 pieces that a run of `count` nodes is split into
+constexpr u64 exec_piece_size(u64 count) noexcept {
+    u64 size = 1;
+    while (size * 16 < count) {
+        size *= 16;
+    }
+    return size;
+}
+
+// Apply a run of several nodes to the stack: Split it into pieces and apply them in turn, using a
+// left fold. Each piece is itself a run that is split again, so the depth of nesting grows only
+// with the logarithm of the number of nodes.
+template <tn Stack, tn Src, tn Ns, u64 Begin, u64 Count, u64... I>
+auto exec_pieces(exec_state<Stack> s, std::integer_sequence<u64, I...>*)
+    -> decltype((s >> ... >> exec_run<Src,
+                                      Ns,
+                                      Begin + I * exec_piece_size(Count),
+                                      std::min(exec_piece_size(Count),
+                                               Count - I * exec_piece_size(Count))>{}));
+
+template <tn Stack, tn Src, tn Ns, u64 Begin, u64 Count>
+    requires(Count != 1)
+auto operator>>(exec_state<Stack> s, exec_run<Src, Ns, Begin, Count>)
+    -> decltype(exec_pieces<Stack, Src, Ns, Begin, Count>(
+        s,
+        static_cast<std::make_integer_sequence<u64,
+                                               (Count + exec_piece_size(Count) - 1)
+                                                   / exec_piece_size(Count)>*>(nullptr)));
+
+// Apply a single node to the stack
+template <tn Stack, tn Src, tn Ns, u64 Begin, node N = Ns::at(Begin)>
+    requires(N.kind != k_block_begin)
+auto operator>>(exec_state<Stack>, exec_run<Src, Ns, Begin, 1>)
+    -> exec_state<tn executor::step<N.kind>::template f<Src, N.n, Stack>>;
+
+// Apply a block: Execute the block on its own. The block is then keyed on only its own code, so an
+// identical block in another program will reuse the same parse.
+template <tn Stack, tn Src, tn Ns, u64 Begin, node N = Ns::at(Begin)>
+    requires(N.kind == k_block_begin)
+auto operator>>(exec_state<Stack>, exec_run<Src, Ns, Begin, 1>) -> exec_state<
+    push_front<Stack,
+               block<executor::exec_parse_t<tn Src::template sub<N.n>,
+                                            tn Ns::template block<Begin>>>>>;
+
 struct token_iter {
-    const token* _base;
+    const token*                   _base;
+    const lex::detail::token_range* _ranges;
     // The current position in the token array
     u64 pos = 0;
 
     constexpr const token& get() const noexcept { return _base[pos]; }
+    // The encoded source range of the current token
+    constexpr u64 span() const noexcept { return encode_span(_ranges[pos]); }
+    // The encoded source range from the token at `first` up to (not including) the current token
+    constexpr u64 span_from(u64 first) const noexcept {
+        const auto& last = _ranges[pos - 1];
+        return encode_span({_ranges[first].pos, last.pos + last.len - _ranges[first].pos});
+    }
 };
 
 struct parser3 {
     constexpr static auto parse_primary(node*& into, token_iter& it) {
-        auto       tk = std::string_view(it.get());
-        const char c  = tk.front();
+        auto tk = std::string_view(it.get());
+        if (tk.empty()) {
+            throw "Unexpected end of expression";
+        }
+        const char c = tk.front();
         if (lex::is_alpha(c)) {
-            *into++ = {k_name, static_cast<u64>(it.pos)};
+            *into++ = {k_name, it.span()};
             it.pos++;
         } else if (lex::is_digit(c) or tk.starts_with("¯")) {
-            *into++ = {k_int, static_cast<u64>(it.pos)};
+            *into++ = {k_int, it.span()};
             it.pos++;
         } else if (c == '(') {
             it.pos++;
@@ -233,18 +370,22 @@ struct parser3 {
             }
             it.pos++;
         } else if (c == '{') {
+            // Reserve the opening node. It will record the span of the block's code.
+            node* const begin = into++;
             it.pos++;
+            const u64 first = it.pos;
             parse_top(into, it);
             *into++ = {k_block, 0};
             if (it.get()[0] != '}') {
                 throw "Imbalanced braces";
             }
+            *begin = {k_block_begin, it.span_from(first)};
             it.pos++;
         } else if (tk == "·") {
             *into++ = {k_nothing, 0};
             it.pos++;
         } else {
-            *into++ = {k_name, it.pos};
+            *into++ = {k_name, it.span()};
             it.pos++;
         }
     }
@@ -328,11 +469,19 @@ struct parser3 {
 
     static constexpr void parse_top(node*& into, token_iter& it) { parse_seq(into, it); }
 
-    template <auto Arr>
+    template <cx_str Code, auto Ranges>
     static constexpr auto make_parser() {
-        std::array<node, Arr.size()* 2> ret = {};
-        token_iter                      iter{Arr.data()};
-        auto                            into = ret.data();
+        // The parser only inspects the leading chars of most tokens, so over-long tokens can be
+        // truncated here. Names are taken in full by the executor.
+        std::array<token, Ranges.size()> toks = {};
+        for (std::size_t i = 0; i < Ranges.size(); ++i) {
+            toks[i] = lex::detail::fin_token(Code.data() + Ranges[i].pos,
+                                             std::min<std::size_t>(Ranges[i].len,
+                                                                   lex::max_token_length));
+        }
+        std::array<node, Ranges.size()* 2> ret = {};
+        token_iter                         iter{toks.data(), Ranges.data()};
+        auto                               into = ret.data();
         parse_top(into, iter);
         *into = {k_done, 0};
         return ret;
@@ -341,15 +490,22 @@ struct parser3 {
     template <auto Arr, std::size_t... I>
     static constexpr auto as_vlist(std::index_sequence<I...>) -> vlist<Arr[I]...>;
 
-    template <token... Tokens>
-    auto parse(token_list<Tokens...>*) {
-        // Create a constexpr array of the tokens:
-        constexpr std::array<token, sizeof...(Tokens) + 1> arr = {Tokens...};
+    template <cx_str Code>
+    static auto parse_code() {
+        constexpr auto& ranges = lex::detail::token_ranges_v<Code>;
         // Calculate an array that will instruct the expression regrouper
-        constexpr auto nodes = make_parser<arr>();
-        using ast            = executor<arr>::template exec_parse_t<nodes>;
+        constexpr auto nodes = make_parser<Code, ranges>();
+        using ast            = executor::exec_parse_t<source<Code>, exec_nodes<nodes>>;
         return ptr<ast>{};
     }
+
+    template <token... Tokens>
+    static auto parse(token_list<Tokens...>*) {
+        // Re-join the tokens into source code:
+        constexpr auto code
+            = cx_str_join_v<" ", cx_str<Tokens.size()>{std::string_view(Tokens)}...>;
+        return parse_code<code>();
+    }
 };
 
 }  // namespace parse_detail
@@ -359,7 +515,7 @@ using parse_tokens_t
     = neo::remove_pointer_t<decltype(parse_detail::parser3{}.parse(meta::ptr<AST>{}))>;
 
 template <cx_str Code>
-using parse_t = parse_tokens_t<lex::tokenize_t<Code>>;
+using parse_t = neo::remove_pointer_t<decltype(parse_detail::parser3::parse_code<Code>())>;
 
 }  // namespace lmno
 
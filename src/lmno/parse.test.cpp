@@ -37,6 +37,10 @@ static_assert(
 static_assert(std::same_as<lmno::parse_t<"· add 5">, dyad<nothing, name<"add">, ConstInt64<5>>>);
 static_assert(std::same_as<lmno::parse_t<"⌽ 5">, monad<name<"⌽">, ConstInt64<5>>>);
 
+// Parsing a token_list is the same as parsing the source code
+static_assert(std::same_as<lmno::parse_tokens_t<lmno::lex::tokenize_t<"foo (:hi:) ¯3‿bar ⌽ 5">>,
+                           parse_t<"foo ¯3‿bar ⌽ 5">>);
+
 using e = lmno::parse_t<"foo : bar baz">;
 static_assert(std::same_as<e, monad<monad<name<"foo">, name<"bar">>, name<"baz">>>);
 
@@ -52,6 +56,11 @@ static_assert(std::same_as<lmno::parse_t<"foo (bar) $ baz">,
 static_assert(std::same_as<lmno::parse_t<"foo {bar} $ baz">,
                            monad<monad<name<"foo">, block<name<"bar">>>, name<"baz">>>);
 
+// Blocks are parsed from their own code, including nested blocks and blocks with comments
+static_assert(std::same_as<lmno::parse_t<"{ {α (:hi:)} ω ; 2 (:c:) } {3}">,
+                           monad<block<stmt_seq<monad<block<name<"α">>, name<"ω">>, ConstInt64<2>>>,
+                                 block<ConstInt64<3>>>>);
+
 static_assert(std::same_as<lmno::parse_t<"foo ; bar">, stmt_seq<name<"foo">, name<"bar">>>);
 
 static_assert(std::same_as<lmno::parse_t<"foo ; bar ; baz">,
@@ -73,6 +82,37 @@ using big1 [[maybe_unused]] = lmno::parse_t<
     "÷√π∞··÷√π∞·÷√π∞·÷√π∞·12">;
 static_assert(not std::same_as<big1, void>);
 
+// A program with far more nodes than the default template depth, which the executor applies
+// without recursing once per node:
+constexpr auto many_stmts = [] {
+    // 64 groups of "(1;1;...;1)" with 16 statements each, separated by ';'
+    lmno::cx_str<64 * 33 + 63> code;
+    auto                       out = code.begin();
+    for (int group = 0; group < 64; ++group) {
+        if (group) {
+            *out++ = ';';
+        }
+        *out++ = '(';
+        for (int n = 0; n < 16; ++n) {
+            if (n) {
+                *out++ = ';';
+            }
+            *out++ = '1';
+        }
+        *out++ = ')';
+    }
+    return code;
+}();
+
+template <typename>
+constexpr std::size_t seq_len_v = 0;
+template <typename... Ts>
+constexpr std::size_t seq_len_v<stmt_seq<Ts...>> = sizeof...(Ts);
+
+using big2 = lmno::parse_t<many_stmts>;
+static_assert(seq_len_v<big2> == 64);
+static_assert(seq_len_v<lmno::meta::head<big2>> == 16);
+
 }  // namespace
 
 int main() {}
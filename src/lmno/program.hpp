@@ -0,0 +1,99 @@
+#pragma once
+
+#include "./concepts/typed_constant.hpp"
+#include "./error.hpp"
+#include "./eval.hpp"
+#include "./invoke.hpp"
+#include "./stdlib.hpp"
+#include "./string.hpp"
+
+#include <neo/fwd.hpp>
+
+#include <concepts>
+#include <type_traits>
+
+namespace lmno {
+
+namespace program_detail {
+
+// Delays a static_assert until instantiation
+template <typename>
+constexpr bool dependent_false = false;
+
+/// Convert the result of a program to the declared return type. Ranges are copied into the
+/// return type element-by-element.
+template <typename Ret, typename R>
+constexpr Ret convert(R&& r) {
+    if constexpr (LMNO_IS_ERROR(r)) {
+        static_assert(dependent_false<R>, "The program could not be evaluated (See R)");
+    } else if constexpr (std::is_void_v<Ret>) {
+        return;
+    } else if constexpr (std::constructible_from<Ret, unconst_t<R&&>>) {
+        return Ret(lmno::unconst(NEO_FWD(r)));
+    } else if constexpr (stdlib::input_range_convertible<unconst_t<R&&>>) {
+        Ret ret;
+        for (auto&& el : stdlib::as_range(lmno::unconst(NEO_FWD(r)))) {
+            ret.insert(ret.end(), NEO_FWD(el));
+        }
+        return ret;
+    } else {
+        static_assert(dependent_false<R>,
+                      "The result of the program is not convertible to the declared return type");
+    }
+}
+
+}  // namespace program_detail
+
+/**
+ * @brief An lmno program with a fixed C++ signature.
+ *
+ * Every translation unit that uses lmno::eval<Code>() must tokenize, parse, and evaluate the code,
+ * and resolve all of the invocations within it. A program has a call operator that is an ordinary
+ * (non-inline) member function, so it can be explicitly instantiated once, in a single translation
+ * unit, and only declared elsewhere. See LMNO_EXTERN_PROGRAM and LMNO_INSTANTIATE_PROGRAM.
+ *
+ * If the signature has no parameters, the call operator returns the value of the code. Otherwise,
+ * the code must evaluate to a function, and the call operator invokes it with the arguments.
+ *
+ * @tparam Code The program code
+ * @tparam Signature The C++ function type of the call operator, e.g. `std::int64_t(int)`
+ */
+template <cx_str Code, typename Signature>
+class program;
+
+template <cx_str Code, typename Ret, typename... Args>
+class program<Code, Ret(Args...)> {
+public:
+    Ret operator()(Args... args) const;
+};
+
+template <cx_str Code, typename Ret, typename... Args>
+Ret program<Code, Ret(Args...)>::operator()(Args... args) const {
+    if constexpr (sizeof...(Args) == 0) {
+        return program_detail::convert<Ret>(lmno::eval<Code>());
+    } else {
+        return program_detail::convert<Ret>(lmno::invoke(lmno::eval<Code>(), NEO_FWD(args)...));
+    }
+}
+
+/**
+ * @brief An instance of lmno::program<Code, Signature>
+ */
+template <cx_str Code, typename Signature>
+constexpr inline program<Code, Signature> program_v{};
+
+}  // namespace lmno
+
+/**
+ * @brief Declare that lmno::program<Code, Signature...> is instantiated in another translation
+ * unit, so that it is not instantiated in this one. Use this in a header that is shared by every
+ * user of the program.
+ */
+#define LMNO_EXTERN_PROGRAM(Code, ...)                                                             \
+    extern template class ::lmno::program<Code, __VA_ARGS__>
+
+/**
+ * @brief Instantiate lmno::program<Code, Signature...>. Use this in exactly one translation unit
+ * for each program that is declared with LMNO_EXTERN_PROGRAM.
+ */
+#define LMNO_INSTANTIATE_PROGRAM(Code, ...) template class ::lmno::program<Code, __VA_ARGS__>
@@ -0,0 +1,26 @@
+#include "./program.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// These would usually be in a shared header (See tools/gen_programs.py):
+LMNO_EXTERN_PROGRAM("/:+∘⍳", std::int64_t(std::int64_t));
+LMNO_EXTERN_PROGRAM("{α + ω × 2}", int(int, int));
+LMNO_EXTERN_PROGRAM("/:+ $ ⍳ 10", std::int64_t());
+LMNO_EXTERN_PROGRAM("⌽", std::vector<int>(const std::vector<int>&));
+
+TEST_CASE("Call an explicitly instantiated program") {
+    CHECK(lmno::program_v<"/:+∘⍳", std::int64_t(std::int64_t)>(5) == 10);
+    CHECK(lmno::program_v<"{α + ω × 2}", int(int, int)>(1, 4) == 9);
+    CHECK(lmno::program_v<"/:+ $ ⍳ 10", std::int64_t()>() == 45);
+    CHECK(lmno::program_v<"⌽", std::vector<int>(const std::vector<int>&)>({1, 2, 3})
+          == std::vector<int>{3, 2, 1});
+}
+
+// ... and these in a single translation unit:
+LMNO_INSTANTIATE_PROGRAM("/:+∘⍳", std::int64_t(std::int64_t));
+LMNO_INSTANTIATE_PROGRAM("{α + ω × 2}", int(int, int));
+LMNO_INSTANTIATE_PROGRAM("/:+ $ ⍳ 10", std::int64_t());
+LMNO_INSTANTIATE_PROGRAM("⌽", std::vector<int>(const std::vector<int>&));
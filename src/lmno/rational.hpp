@@ -4,12 +4,34 @@
 
 #include <cmath>
 #include <cstdint>
+#include <limits>
 #include <numeric>
+#include <utility>
 
 namespace lmno {
 
+namespace rational_detail {
+
+// Intermediate results of rational arithmetic are computed with twice the width of the numerator
+// and denominator, so that overflow can be detected before the result is reduced.
+__extension__ typedef __int128 wide_int;
+
+/// Convert a wide intermediate result back to an int64_t, or throw if it is out of range
+constexpr std::int64_t narrow(wide_int v) {
+    if (v > std::numeric_limits<std::int64_t>::max()
+        or v < std::numeric_limits<std::int64_t>::min()) {
+        throw "Integer overflow in rational arithmetic";
+    }
+    return static_cast<std::int64_t>(v);
+}
+
+}  // namespace rational_detail
+
 /**
  * @brief A rational number, represented using two integers
+ *
+ * Arithmetic is exact. If the reduced result of an operation cannot be represented using 64-bit
+ * integers, the operation throws.
  */
 class rational {
 public:
@@ -19,10 +41,60 @@ public:
     std::int64_t _priv_denominator;
 
 private:
-    // Delegated constructor that normalizes the values
-    constexpr rational(std::int64_t gcd, std::int64_t n, std::int64_t d) noexcept
-        : _priv_numerator(n / gcd)
-        , _priv_denominator(d / gcd) {}
+    using wide_int = rational_detail::wide_int;
+
+    struct reduced_tag {};
+
+    // Construct from a numerator and (positive) denominator that are already in lowest terms
+    constexpr rational(reduced_tag, std::int64_t n, std::int64_t d) noexcept
+        : _priv_numerator(n)
+        , _priv_denominator(d) {}
+
+    // Reduce the given ratio to lowest terms with a positive denominator
+    static constexpr rational _normalize(wide_int n, wide_int d) {
+        if (d == 0) {
+            throw "Division by zero in rational arithmetic";
+        }
+        if (d < 0) {
+            n = -n;
+            d = -d;
+        }
+        wide_int a = n < 0 ? -n : n;
+        wide_int b = d;
+        while (b != 0) {
+            a = std::exchange(b, a % b);
+        }
+        n /= a;
+        d /= a;
+        return rational{reduced_tag{}, rational_detail::narrow(n), rational_detail::narrow(d)};
+    }
+
+    // Compute (an/ad) + (bn/bd) for two reduced rationals
+    static constexpr rational
+    _add(std::int64_t an, std::int64_t ad, std::int64_t bn, std::int64_t bd) {
+        if (ad == 1 and bd == 1) {
+            // Integer addition: No need to reduce
+            return rational{reduced_tag{},
+                            rational_detail::narrow(wide_int(an) + wide_int(bn)),
+                            1};
+        }
+        // Since both inputs are in lowest terms, the only common factors that the sum of the
+        // cross products can share with the product of the denominators are factors of g
+        // (Knuth, TAOCP Vol. 2, 4.5.1), so the result needs at most one more gcd() to reduce.
+        const std::int64_t g   = std::gcd(ad, bd);
+        const std::int64_t adg = ad / g;
+        const std::int64_t bdg = bd / g;
+        wide_int           n   = wide_int(an) * bdg + wide_int(bn) * adg;
+        wide_int           d   = wide_int(adg) * bd;
+        if (g != 1) {
+            const std::int64_t g2 = std::gcd(static_cast<std::int64_t>(n % g), g);
+            if (g2 > 1) {
+                n /= g2;
+                d /= g2;
+            }
+        }
+        return rational{reduced_tag{}, rational_detail::narrow(n), rational_detail::narrow(d)};
+    }
 
 public:
     /**
@@ -31,8 +103,8 @@ public:
      * Will be normalized into it's most-reduces form, and the denominator will
      * always be positive, i.e. rational{2, -4} == rational{-9, 18}
      */
-    [[nodiscard]] constexpr explicit rational(std::int64_t n, std::int64_t d) noexcept
-        : rational(std::gcd(n, d), n, d) {}
+    [[nodiscard]] constexpr explicit rational(std::int64_t n, std::int64_t d)
+        : rational(_normalize(n, d)) {}
 
     /**
      * @brief Create a rational number equivalent to the given integer.
@@ -52,31 +124,46 @@ public:
     [[nodiscard]] bool operator==(const rational&) const = default;
 
     // Add two rational numbers together
-    [[nodiscard]] constexpr rational operator+(rational other) const noexcept {
-        const auto new_d = std::lcm(_priv_denominator, other._priv_denominator);
-        const auto lfac  = new_d / _priv_denominator;
-        const auto rfac  = new_d / other._priv_denominator;
-        const auto lnum  = _priv_numerator * lfac;
-        const auto rnum  = other._priv_numerator * rfac;
-        return rational{static_cast<std::int64_t>(lnum + rnum), new_d};
+    [[nodiscard]] constexpr rational operator+(rational other) const {
+        return _add(_priv_numerator,
+                    _priv_denominator,
+                    other._priv_numerator,
+                    other._priv_denominator);
     }
 
     // Swap the sign of the numerator
-    [[nodiscard]] constexpr rational operator-() const noexcept {
-        return rational{-_priv_numerator, _priv_denominator};
+    [[nodiscard]] constexpr rational operator-() const {
+        return rational{reduced_tag{},
+                        rational_detail::narrow(-wide_int(_priv_numerator)),
+                        _priv_denominator};
     }
 
     // Subtract two rationals
-    [[nodiscard]] constexpr rational operator-(rational other) const noexcept {
+    [[nodiscard]] constexpr rational operator-(rational other) const {
+        if (_priv_denominator == 1 and other._priv_denominator == 1) {
+            return rational{reduced_tag{},
+                            rational_detail::narrow(wide_int(_priv_numerator)
+                                                    - wide_int(other._priv_numerator)),
+                            1};
+        }
         return *this + -(other);
     }
 
     // Multiply two rationals together
-    [[nodiscard]] constexpr rational operator*(rational other) const noexcept {
-        const auto n = _priv_numerator * other._priv_numerator;
-        const auto d = _priv_denominator * other._priv_denominator;
-        // The constructor will reduce the terms, if necessary:
-        return rational{n, d};
+    [[nodiscard]] constexpr rational operator*(rational other) const {
+        if (_priv_denominator == 1 and other._priv_denominator == 1) {
+            return rational{reduced_tag{},
+                            rational_detail::narrow(wide_int(_priv_numerator)
+                                                    * wide_int(other._priv_numerator)),
+                            1};
+        }
+        // Cross-reduce before multiplying, so that the product is already in lowest terms
+        const std::int64_t g1 = std::gcd(_priv_numerator, other._priv_denominator);
+        const std::int64_t g2 = std::gcd(other._priv_numerator, _priv_denominator);
+        // (If a numerator is zero, then its g is the other denominator, which is non-zero)
+        const wide_int n = wide_int(_priv_numerator / g1) * (other._priv_numerator / g2);
+        const wide_int d = wide_int(_priv_denominator / g2) * (other._priv_denominator / g1);
+        return rational{reduced_tag{}, rational_detail::narrow(n), rational_detail::narrow(d)};
     }
 
     // Divide two rational numbers
@@ -90,7 +177,15 @@ public:
      * @return constexpr rational
      */
     [[nodiscard]] constexpr rational recip() const {
-        return rational{_priv_denominator, _priv_numerator};
+        // Swapping the terms of a reduced rational leaves it reduced, so only the sign needs fixing
+        if (_priv_numerator == 0) {
+            throw "Division by zero in rational arithmetic";
+        } else if (_priv_numerator < 0) {
+            return rational{reduced_tag{},
+                            rational_detail::narrow(-wide_int(_priv_denominator)),
+                            rational_detail::narrow(-wide_int(_priv_numerator))};
+        }
+        return rational{reduced_tag{}, _priv_denominator, _priv_numerator};
     }
 
     [[nodiscard]] constexpr double as_double() const noexcept {
@@ -109,31 +204,31 @@ public:
 
     // Math with other types will promote
     // +
-    [[nodiscard]] friend constexpr rational operator+(rational q, neo::integral auto n) noexcept {
+    [[nodiscard]] friend constexpr rational operator+(rational q, neo::integral auto n) {
         return q + rational{n};
     }
-    [[nodiscard]] friend constexpr rational operator+(neo::integral auto n, rational q) noexcept {
+    [[nodiscard]] friend constexpr rational operator+(neo::integral auto n, rational q) {
         return rational{n} + q;
     }
     // -
-    [[nodiscard]] friend constexpr rational operator-(rational q, neo::integral auto n) noexcept {
+    [[nodiscard]] friend constexpr rational operator-(rational q, neo::integral auto n) {
         return q - rational{n};
     }
-    [[nodiscard]] friend constexpr rational operator-(neo::integral auto n, rational q) noexcept {
+    [[nodiscard]] friend constexpr rational operator-(neo::integral auto n, rational q) {
         return rational{n} - q;
     }
     // ×
-    [[nodiscard]] friend constexpr rational operator*(rational q, neo::integral auto n) noexcept {
+    [[nodiscard]] friend constexpr rational operator*(rational q, neo::integral auto n) {
         return q * rational{n};
     }
-    [[nodiscard]] friend constexpr rational operator*(neo::integral auto n, rational q) noexcept {
+    [[nodiscard]] friend constexpr rational operator*(neo::integral auto n, rational q) {
         return rational{n} * q;
     }
     // ÷
-    [[nodiscard]] friend constexpr rational operator/(rational q, neo::integral auto n) noexcept {
+    [[nodiscard]] friend constexpr rational operator/(rational q, neo::integral auto n) {
         return q / rational{n};
     }
-    [[nodiscard]] friend constexpr rational operator/(neo::integral auto n, rational q) noexcept {
+    [[nodiscard]] friend constexpr rational operator/(neo::integral auto n, rational q) {
         return rational{n} / q;
     }
 };
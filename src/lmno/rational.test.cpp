@@ -0,0 +1,55 @@
+#include "./rational.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <limits>
+
+using lmno::rational;
+
+constexpr auto i64_max = std::numeric_limits<std::int64_t>::max();
+constexpr auto i64_min = std::numeric_limits<std::int64_t>::min();
+
+// Normalization
+static_assert(rational{2, -4} == rational{-9, 18});
+static_assert(rational{2, -4}.denominator() == 2);
+static_assert(rational{2, -4}.numerator() == -1);
+static_assert(rational{0, -7} == rational{0});
+static_assert(rational{i64_min, i64_min} == rational{1});
+
+// Addition and subtraction
+static_assert(rational{1, 6} + rational{1, 3} == rational{1, 2});
+static_assert(rational{1, 6} + rational{-1, 6} == rational{0});
+static_assert(rational{3, 4} - rational{1, 4} == rational{1, 2});
+static_assert(rational{5} + rational{7} == rational{12});
+static_assert(rational{5} - rational{7} == rational{-2});
+static_assert(rational{1, 2} + 1 == rational{3, 2});
+
+// Intermediate values that would overflow 64 bits, but whose reduced result does not
+static_assert(rational{1, i64_max} + rational{1, i64_max} == rational{2, i64_max});
+static_assert(rational{i64_max - 1, i64_max} + rational{1, i64_max} == rational{1});
+static_assert(rational{i64_max, 2} - rational{i64_max - 2, 2} == rational{1});
+
+// Multiplication and division
+static_assert(rational{2, 3} * rational{3, 4} == rational{1, 2});
+static_assert(rational{-2, 3} * rational{3, -4} == rational{1, 2});
+static_assert(rational{0} * rational{3, 4} == rational{0});
+static_assert(rational{i64_max, 3} * rational{3, i64_max} == rational{1});
+static_assert(rational{i64_max, 2} * 2 == rational{i64_max});
+static_assert(rational{4} / 6 == rational{2, 3});
+static_assert(rational{-4} / 6 == rational{-2, 3});
+static_assert(rational{4} / -6 == rational{-2, 3});
+static_assert(rational{-3, 7}.recip() == rational{-7, 3});
+static_assert(rational{-3, 7}.recip().denominator() == 3);
+
+TEST_CASE("Rational arithmetic that overflows will throw") {
+    CHECK_THROWS(rational{i64_max} + 1);
+    CHECK_THROWS(rational{i64_min} - 1);
+    CHECK_THROWS(rational{i64_max} * 2);
+    CHECK_THROWS(rational{1, i64_max} + rational{1, i64_max - 1});
+    CHECK_THROWS(rational{1, i64_max} * rational{1, 2});
+    CHECK_THROWS(-rational{i64_min});
+    CHECK_THROWS(rational{0}.recip());
+    CHECK_THROWS(rational{3} / 0);
+    CHECK_NOTHROW(rational{i64_max} + -1);
+}
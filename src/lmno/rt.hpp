@@ -0,0 +1,11 @@
+#pragma once
+
+#include "./rt/adapt.hpp"
+#include "./rt/bytecode.hpp"
+#include "./rt/column.hpp"
+#include "./rt/engine.hpp"
+#include "./rt/interp.hpp"
+#include "./rt/parse.hpp"
+#include "./rt/registry.hpp"
+#include "./rt/value.hpp"
+#include "./rt/vm.hpp"
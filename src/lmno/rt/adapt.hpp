@@ -0,0 +1,141 @@
+#pragma once
+
+#include "./value.hpp"
+
+#include "../concepts/typed_constant.hpp"
+#include "../const.hpp"
+#include "../invoke.hpp"
+#include "../stdlib/numeric.hpp"
+#include "../stdlib/ranges.hpp"
+
+#include <neo/fwd.hpp>
+
+#include <concepts>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace lmno::rt {
+
+namespace adapt_detail {
+
+/// Match types that map directly onto an alternative of rt::value
+template <typename T>
+concept value_data = std::same_as<T, value> or std::same_as<T, ast::nothing>
+    or std::integral<T> or std::floating_point<T> or std::same_as<T, rational>
+    or std::same_as<T, array> or std::same_as<T, function> or typed_constant<T>;
+
+/// Match types that are materialized into an rt::array
+template <typename T>
+concept array_like = (not value_data<T>) and stdlib::as_range_convertible<T&>;
+
+}  // namespace adapt_detail
+
+/**
+ * @brief Match any type that can be converted to an rt::value with rt::to_value()
+ */
+template <typename T>
+concept value_convertible
+    = adapt_detail::value_data<neo::remove_cvref_t<T>>
+    or adapt_detail::array_like<neo::remove_cvref_t<T>>;
+
+template <value_convertible T>
+value to_value(T&& v);
+
+/**
+ * @brief A runtime function that wraps a statically-typed invocable.
+ *
+ * Invoking the function visits the alternatives of the argument values and invokes the wrapped
+ * object with the concrete types. If the wrapped object is not invocable with those types, or the
+ * result has no runtime representation, throws an rt::error.
+ *
+ * @tparam F The invocable object, e.g. one of the define<> stdlib entities
+ */
+template <typename F>
+class callable : public function_impl {
+    NEO_NO_UNIQUE_ADDRESS F _fn;
+    std::string             _name;
+
+    template <typename... Args>
+    value _apply(const Args&... args) const {
+        if constexpr (lmno::invocable<const F&, const Args&...>
+                      and value_convertible<invoke_t<const F&, const Args&...>>) {
+            try {
+                return rt::to_value(lmno::invoke(_fn, args...));
+            } catch (const char* message) {
+                throw error(message);
+            }
+        } else {
+            std::string message = "Cannot apply '" + _name + "' to (";
+            ((message += value::type_name<Args>(), message += ", "), ...);
+            message.resize(message.size() - 2);
+            throw error(message + ")");
+        }
+    }
+
+public:
+    explicit callable(F fn, std::string name)
+        : _fn(NEO_MOVE(fn))
+        , _name(NEO_MOVE(name)) {}
+
+    std::string name() const override { return _name; }
+
+    value call(const value& x) const override {
+        return std::visit([&](const auto& a) { return this->_apply(a); }, x.variant());
+    }
+
+    value call(const value& w, const value& x) const override {
+        return std::visit(
+            [&]<typename W, typename X>(const W& a, const X& b) {
+                // Mixed integer and float operands are both promoted to float
+                if constexpr (std::same_as<W, std::int64_t> and std::same_as<X, double>) {
+                    return this->_apply(static_cast<double>(a), b);
+                } else if constexpr (std::same_as<W, double> and std::same_as<X, std::int64_t>) {
+                    return this->_apply(a, static_cast<double>(b));
+                } else {
+                    return this->_apply(a, b);
+                }
+            },
+            w.variant(),
+            x.variant());
+    }
+
+    std::optional<value> identity() const override {
+        if constexpr (non_error<decltype(stdlib::identity_element<std::int64_t, F>)>) {
+            return value(stdlib::identity_element<std::int64_t, F>);
+        } else {
+            return std::nullopt;
+        }
+    }
+};
+
+/**
+ * @brief Convert a statically-typed object into a runtime value
+ *
+ * @param v The object to convert. Typed constants are unwrapped, arithmetic types and rationals
+ * become scalars, and ranges are materialized into an rt::array.
+ */
+template <value_convertible T>
+value to_value(T&& v) {
+    using U = neo::remove_cvref_t<T>;
+    if constexpr (typed_constant<U>) {
+        return rt::to_value(lmno::unconst(v));
+    } else if constexpr (adapt_detail::value_data<U>) {
+        return value(NEO_FWD(v));
+    } else {
+        array arr;
+        auto&& rng = stdlib::as_range(v);
+        if constexpr (std::ranges::sized_range<decltype(rng)>) {
+            arr.reserve(static_cast<std::size_t>(std::ranges::size(rng)));
+        }
+        for (auto&& el : rng) {
+            arr.push_back(rt::to_value(NEO_FWD(el)));
+        }
+        return arr;
+    }
+}
+
+}  // namespace lmno::rt
@@ -0,0 +1,406 @@
+#pragma once
+
+#include "./parse.hpp"
+#include "./registry.hpp"
+#include "./value.hpp"
+
+#include <neo/fwd.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace lmno::rt {
+
+/**
+ * @brief The operations of the bytecode virtual machine. See rt::vm.
+ */
+enum class opcode : std::uint8_t {
+    /// Push constant [arg]
+    push_const,
+    /// Push nothing "·"
+    push_nothing,
+    /// Push a copy of the local slot [arg]
+    load_local,
+    /// Push a copy of the global [arg]
+    load_global,
+    /// Throw an error for the undefined name [arg]
+    load_undefined,
+    /// Pop the top value into the local slot [arg]
+    store_local,
+    /// Discard the top value
+    pop,
+    /// Pop X and F, and push F(X)
+    call1,
+    /// Pop X, F, and W, and push W F X
+    call2,
+    /// Pop X, and push F(X), where F is the global [arg]
+    call1_global,
+    /// Pop X and W, and push W F X, where F is the global [arg]
+    call2_global,
+
+    // The scalar primitives. Each applies directly to two integers or two floats, and otherwise
+    // calls the global [arg] that it stands for, like call1_global or call2_global.
+
+    /// Pop X and push -X
+    negate,
+    /// Pop X and W, and push W + X
+    add,
+    /// Pop X and W, and push W - X
+    subtract,
+    /// Pop X and W, and push W × X
+    multiply,
+    /// Pop X and W, and push W = X
+    equal,
+    /// Pop X and W, and push W ≠ X
+    not_equal,
+    /// Pop X and W, and push W < X
+    less,
+    /// Pop X and W, and push W ≤ X
+    less_equal,
+    /// Pop X and W, and push W > X
+    greater,
+    /// Pop X and W, and push W ≥ X
+    greater_equal,
+    /// Pop X and W, and push W ⌊ X
+    min,
+    /// Pop X and W, and push W ⌈ X
+    max,
+    /// Pop the top [arg] values, and push an array of them
+    make_array,
+    /// Push a closure of the code segment [arg], capturing values from the current frame
+    make_closure,
+    /// Pop the top value and return it
+    ret,
+};
+
+/**
+ * @brief A single bytecode instruction
+ */
+struct instruction {
+    opcode op;
+    /// The operand of the instruction. Meaning depends on the opcode.
+    std::uint32_t arg = 0;
+};
+
+/**
+ * @brief A value captured by a closure from the frame where the closure was created
+ */
+struct capture {
+    /// The slot in the enclosing frame
+    std::uint32_t outer;
+    /// The slot in the closure's frame
+    std::uint32_t inner;
+};
+
+/**
+ * @brief The compiled code of a block, or of the top level of a program
+ */
+struct code_segment {
+    std::vector<instruction> code;
+    /// The number of local slots in a frame. For blocks, slots 0 and 1 hold α and ω.
+    std::uint32_t n_slots = 0;
+    /// The maximum depth of the operand stack, which sits above the local slots
+    std::uint32_t max_depth = 0;
+    /// The values that are copied into a new closure of this segment
+    std::vector<capture> captures;
+};
+
+/**
+ * @brief A compiled program. segments[0] is the top level of the program.
+ */
+struct bytecode : std::enable_shared_from_this<bytecode> {
+    std::vector<code_segment> segments;
+    std::vector<value>        constants;
+    /// The registry values for the names that the program uses
+    std::vector<value> globals;
+    /// The names in the program, used to report undefined names
+    std::vector<std::string> names;
+    /// For each segment that captures nothing, the one closure object that every evaluation of
+    /// its block shares. Filled by rt::share_bytecode(), once the bytecode has its final address.
+    std::vector<std::unique_ptr<const function_impl>> shared_closures;
+};
+
+namespace bytecode_detail {
+
+/// The scalar primitive opcodes for the monadic and dyadic uses of a name
+struct primitive {
+    std::string_view      name;
+    std::optional<opcode> monadic;
+    std::optional<opcode> dyadic;
+};
+
+inline constexpr primitive primitives[] = {
+    {"+", std::nullopt, opcode::add},
+    {"-", opcode::negate, opcode::subtract},
+    {"×", std::nullopt, opcode::multiply},
+    {"=", std::nullopt, opcode::equal},
+    {"≠", std::nullopt, opcode::not_equal},
+    {"<", std::nullopt, opcode::less},
+    {"≤", std::nullopt, opcode::less_equal},
+    {">", std::nullopt, opcode::greater},
+    {"≥", std::nullopt, opcode::greater_equal},
+    {"⌊", std::nullopt, opcode::min},
+    {"⌈", std::nullopt, opcode::max},
+};
+
+/**
+ * @brief The names visible while compiling a code segment
+ */
+struct scope {
+    scope*        parent;
+    std::uint32_t segment;
+    /// The current depth of the operand stack
+    std::uint32_t depth = 0;
+    /// Local (name, slot) bindings. Searched from the back, so later bindings shadow earlier ones.
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> locals{};
+    /// (name, slot) of values captured from enclosing scopes
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> captured{};
+};
+
+/**
+ * @brief Compiles a syntax_tree to bytecode. Evaluation order and semantics match
+ * interp_detail::evaluator.
+ */
+struct compiler {
+    const syntax_tree&        tree;
+    bytecode                  out;
+    std::vector<std::int64_t> global_index{};
+    /// The scalar primitive that each name stands for, if any
+    std::vector<const primitive*> global_primitive{};
+
+    compiler(const syntax_tree& t, const registry& reg)
+        : tree(t) {
+        out.names = tree.names;
+        for (auto c : tree.constants) {
+            out.constants.emplace_back(c);
+        }
+        // Resolve the names that are defined in the registry ahead of time. Local bindings may
+        // still shadow them.
+        for (auto& name : tree.names) {
+            auto def = reg.find(name);
+            if (def) {
+                global_index.push_back(static_cast<std::int64_t>(out.globals.size()));
+                out.globals.push_back(*def);
+            } else {
+                global_index.push_back(-1);
+            }
+            global_primitive.push_back(find_primitive(name, def));
+        }
+    }
+
+    // A name is only a primitive if it is bound to the same function as in the default registry
+    static const primitive* find_primitive(std::string_view name, const value* def) {
+        auto prim = std::ranges::find(primitives, name, &primitive::name);
+        if (def == nullptr or prim == std::ranges::end(primitives)) {
+            return nullptr;
+        }
+        auto builtin = default_registry().find(name);
+        return builtin and *builtin == *def ? prim : nullptr;
+    }
+
+    code_segment& segment(const scope& sc) { return out.segments[sc.segment]; }
+
+    // Emit an instruction that grows the operand stack by `effect`
+    void emit(scope& sc, opcode op, std::uint32_t arg, int effect) {
+        auto& seg = segment(sc);
+        seg.code.push_back({op, arg});
+        sc.depth = static_cast<std::uint32_t>(static_cast<int>(sc.depth) + effect);
+        seg.max_depth = (std::max)(seg.max_depth, sc.depth);
+    }
+
+    std::uint32_t new_slot(scope& sc) { return segment(sc).n_slots++; }
+
+    // Whether the name is bound in the given scope or any that encloses it
+    static bool is_local(const scope* sc, std::uint32_t name) {
+        for (; sc; sc = sc->parent) {
+            auto same = [&](auto& binding) { return binding.first == name; };
+            if (std::ranges::any_of(sc->locals, same) or std::ranges::any_of(sc->captured, same)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // If the function of a call is a name that refers to a global, the global's index
+    std::optional<std::uint32_t> global_function(const scope& sc, const syntax_node& fn) {
+        if (fn.kind != node_kind::name or is_local(&sc, fn.first) or global_index[fn.first] < 0) {
+            return std::nullopt;
+        }
+        return static_cast<std::uint32_t>(global_index[fn.first]);
+    }
+
+    // Emit a monadic call. A global function is called by its index, without pushing it.
+    void compile_call1(scope& sc, const syntax_node& fn, const syntax_node& x) {
+        if (auto global = global_function(sc, fn)) {
+            compile(sc, x);
+            auto prim = global_primitive[fn.first];
+            auto op   = prim and prim->monadic ? *prim->monadic : opcode::call1_global;
+            emit(sc, op, *global, 0);
+        } else {
+            compile(sc, fn);
+            compile(sc, x);
+            emit(sc, opcode::call1, 0, -1);
+        }
+    }
+
+    // Emit a dyadic call, in the same manner as compile_call1()
+    void compile_call2(scope&             sc,
+                       const syntax_node& w,
+                       const syntax_node& fn,
+                       const syntax_node& x) {
+        if (auto global = global_function(sc, fn)) {
+            compile(sc, w);
+            compile(sc, x);
+            auto prim = global_primitive[fn.first];
+            auto op   = prim and prim->dyadic ? *prim->dyadic : opcode::call2_global;
+            emit(sc, op, *global, -1);
+        } else {
+            compile(sc, w);
+            compile(sc, fn);
+            compile(sc, x);
+            emit(sc, opcode::call2, 0, -2);
+        }
+    }
+
+    // Find the slot for the given name, capturing it from an enclosing scope if needed
+    std::optional<std::uint32_t> resolve(scope& sc, std::uint32_t name) {
+        for (auto it = sc.locals.rbegin(); it != sc.locals.rend(); ++it) {
+            if (it->first == name) {
+                return it->second;
+            }
+        }
+        for (auto& [n, slot] : sc.captured) {
+            if (n == name) {
+                return slot;
+            }
+        }
+        if (sc.parent == nullptr) {
+            return std::nullopt;
+        }
+        auto outer = resolve(*sc.parent, name);
+        if (not outer) {
+            return std::nullopt;
+        }
+        auto slot = new_slot(sc);
+        segment(sc).captures.push_back({*outer, slot});
+        sc.captured.emplace_back(name, slot);
+        return slot;
+    }
+
+    void compile_name(scope& sc, std::uint32_t name) {
+        if (auto slot = resolve(sc, name)) {
+            emit(sc, opcode::load_local, *slot, 1);
+        } else if (global_index[name] >= 0) {
+            emit(sc, opcode::load_global, static_cast<std::uint32_t>(global_index[name]), 1);
+        } else {
+            // This is only an error if it is evaluated
+            emit(sc, opcode::load_undefined, name, 1);
+        }
+    }
+
+    void compile_block(scope& sc, const syntax_node& body) {
+        auto seg_index = static_cast<std::uint32_t>(out.segments.size());
+        out.segments.emplace_back();
+        scope inner{&sc, seg_index};
+        out.segments[seg_index].n_slots = 2;
+        if (auto alpha = tree.find_name("α"); alpha >= 0) {
+            inner.locals.emplace_back(static_cast<std::uint32_t>(alpha), 0);
+        }
+        if (auto omega = tree.find_name("ω"); omega >= 0) {
+            inner.locals.emplace_back(static_cast<std::uint32_t>(omega), 1);
+        }
+        compile(inner, body);
+        emit(inner, opcode::ret, 0, -1);
+        emit(sc, opcode::make_closure, seg_index, 1);
+    }
+
+    void compile_stmts(scope& sc, const syntax_node& seq) {
+        const auto n_locals = sc.locals.size();
+        for (std::uint32_t i = 0; i + 1 < seq.count; ++i) {
+            auto& stmt = tree.child(seq, i);
+            if (stmt.kind == node_kind::assignment) {
+                // Bind the name for the subsequent statements
+                compile(sc, tree.child(stmt, 1));
+                auto slot = new_slot(sc);
+                emit(sc, opcode::store_local, slot, -1);
+                sc.locals.emplace_back(tree.child(stmt, 0).first, slot);
+            } else {
+                compile(sc, stmt);
+                emit(sc, opcode::pop, 0, -1);
+            }
+        }
+        compile(sc, tree.child(seq, seq.count - 1));
+        // The names go out of scope at the end of the sequence
+        sc.locals.resize(n_locals);
+    }
+
+    void compile(scope& sc, const syntax_node& n) {
+        switch (n.kind) {
+        case node_kind::nothing:
+            emit(sc, opcode::push_nothing, 0, 1);
+            return;
+        case node_kind::constant:
+            emit(sc, opcode::push_const, n.first, 1);
+            return;
+        case node_kind::name:
+            compile_name(sc, n.first);
+            return;
+        case node_kind::monad:
+            compile_call1(sc, tree.child(n, 0), tree.child(n, 1));
+            return;
+        case node_kind::dyad:
+            if (tree.child(n, 0).kind == node_kind::nothing) {
+                // A dyad with "·" on the left is a monadic invocation
+                compile_call1(sc, tree.child(n, 1), tree.child(n, 2));
+            } else {
+                compile_call2(sc, tree.child(n, 0), tree.child(n, 1), tree.child(n, 2));
+            }
+            return;
+        case node_kind::block:
+            compile_block(sc, tree.child(n, 0));
+            return;
+        case node_kind::assignment:
+            // A lone assignment, with no subsequent statements. The name goes nowhere.
+            compile(sc, tree.child(n, 1));
+            return;
+        case node_kind::strand:
+            for (std::uint32_t i = 0; i < n.count; ++i) {
+                compile(sc, tree.child(n, i));
+            }
+            emit(sc, opcode::make_array, n.count, 1 - static_cast<int>(n.count));
+            return;
+        case node_kind::stmt_seq:
+            compile_stmts(sc, n);
+            return;
+        }
+    }
+
+    bytecode run() && {
+        out.segments.emplace_back();
+        scope top{nullptr, 0};
+        compile(top, tree.nodes[tree.root]);
+        emit(top, opcode::ret, 0, -1);
+        return NEO_MOVE(out);
+    }
+};
+
+}  // namespace bytecode_detail
+
+/**
+ * @brief Compile a runtime syntax tree to bytecode
+ *
+ * @param tree The code to compile
+ * @param reg The registry of names that are visible to the code
+ */
+inline bytecode compile_bytecode(const syntax_tree& tree, const registry& reg) {
+    return bytecode_detail::compiler{tree, reg}.run();
+}
+
+}  // namespace lmno::rt
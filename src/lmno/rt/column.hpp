@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace lmno::rt {
+
+/**
+ * @brief A runtime-sized column of integers, used by the array engine (See rt/engine.hpp).
+ *
+ * A column either views memory owned by the caller, or shares a buffer that was obtained from a
+ * buffer_pool. Copying a column does not copy its elements.
+ */
+class column {
+public:
+    using buffer = std::vector<std::int64_t>;
+
+private:
+    std::shared_ptr<buffer> _buf;
+    const std::int64_t*     _data = nullptr;
+    std::size_t             _size = 0;
+
+public:
+    column() = default;
+
+    /// Create a column that shares the given buffer
+    explicit column(std::shared_ptr<buffer> buf) noexcept
+        : _buf(std::move(buf))
+        , _data(_buf->data())
+        , _size(_buf->size()) {}
+
+    /// Create a column that views the given elements. The elements must outlive the column.
+    static column view(std::span<const std::int64_t> elems) noexcept {
+        column ret;
+        ret._data = elems.data();
+        ret._size = elems.size();
+        return ret;
+    }
+
+    const std::int64_t* data() const noexcept { return _data; }
+    std::size_t         size() const noexcept { return _size; }
+    const std::int64_t* begin() const noexcept { return _data; }
+    const std::int64_t* end() const noexcept { return _data + _size; }
+    std::int64_t        operator[](std::size_t i) const noexcept { return _data[i]; }
+
+    std::span<const std::int64_t> span() const noexcept { return {_data, _size}; }
+
+    /**
+     * @brief Obtain the buffer of this column if the buffer may be overwritten: It came from a
+     * pool, and no other column shares it. Otherwise, returns nullptr.
+     */
+    const std::shared_ptr<buffer>* writable() const noexcept {
+        // One reference is held by the pool, and the other by this column
+        return _buf.use_count() == 2 ? &_buf : nullptr;
+    }
+
+    friend bool operator==(const column& a, const column& b) noexcept {
+        return std::ranges::equal(a.span(), b.span());
+    }
+};
+
+/**
+ * @brief A set of buffers for columns that are reused once no column refers to them.
+ *
+ * The array engine obtains every intermediate result from a pool, so repeated evaluation does not
+ * allocate once the pool holds enough buffers. Pools are not thread-safe: Columns from the pool
+ * must not be shared between threads.
+ */
+class buffer_pool {
+    std::vector<std::shared_ptr<column::buffer>> _bufs;
+
+public:
+    /// Obtain the pool of the calling thread
+    static buffer_pool& current() noexcept {
+        thread_local buffer_pool inst;
+        return inst;
+    }
+
+    /// Obtain a buffer of `size` elements. The values of the elements are unspecified.
+    std::shared_ptr<column::buffer> acquire(std::size_t size) {
+        std::shared_ptr<column::buffer>* found = nullptr;
+        for (auto& buf : _bufs) {
+            if (buf.use_count() != 1) {
+                // The buffer is in use
+                continue;
+            }
+            found = &buf;
+            if (buf->capacity() >= size) {
+                // Prefer a buffer that will not reallocate
+                break;
+            }
+        }
+        if (found) {
+            (*found)->resize(size);
+            return *found;
+        }
+        return _bufs.emplace_back(std::make_shared<column::buffer>(size));
+    }
+
+    /// Release the memory of the buffers that are not in use
+    void trim() {
+        std::erase_if(_bufs, [](auto& buf) { return buf.use_count() == 1; });
+    }
+
+    /// The number of buffers held by the pool, both in use and free
+    std::size_t size() const noexcept { return _bufs.size(); }
+};
+
+}  // namespace lmno::rt
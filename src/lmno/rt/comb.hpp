@@ -0,0 +1,308 @@
+#pragma once
+
+#include "./value.hpp"
+
+#include <neo/fwd.hpp>
+
+#include <concepts>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace lmno::rt {
+
+/**
+ * @brief A runtime function implemented by an object that is invocable with one or two values.
+ *
+ * This is used for the runtime versions of the stdlib modifiers and combinators. Unlike the
+ * statically-typed versions, these compose runtime functions rather than types, and so do not
+ * need a new C++ type for every composition.
+ */
+template <typename Impl>
+class derived_function : public function_impl {
+    std::string _name;
+    Impl        _impl;
+
+public:
+    explicit derived_function(std::string name, Impl impl)
+        : _name(NEO_MOVE(name))
+        , _impl(NEO_MOVE(impl)) {}
+
+    std::string name() const override { return _name; }
+
+    value call(const value& x) const override {
+        if constexpr (std::invocable<const Impl&, const value&>) {
+            return _impl(x);
+        } else {
+            throw error("'" + _name + "' is not prefix-invocable");
+        }
+    }
+
+    value call(const value& w, const value& x) const override {
+        if constexpr (std::invocable<const Impl&, const value&, const value&>) {
+            return _impl(w, x);
+        } else {
+            throw error("'" + _name + "' is not infix-invocable");
+        }
+    }
+};
+
+/// Create a function named `name` that is implemented by `impl`
+template <typename Impl>
+function make_function(std::string name, Impl impl) {
+    auto impl_ptr = std::make_shared<const derived_function<Impl>>(NEO_MOVE(name), NEO_MOVE(impl));
+    return function(NEO_MOVE(impl_ptr));
+}
+
+namespace comb_detail {
+
+/// Spell an operand for use in the name of a derived function
+inline std::string describe(const value& v) {
+    if (v.holds<function>()) {
+        return v.get<function>().impl().name();
+    } else if (v.holds<std::int64_t>()) {
+        return std::to_string(v.get<std::int64_t>());
+    }
+    return std::string(v.type_name());
+}
+
+/// Obtain the given operand as a function. Values other than functions and nothing "·" are
+/// auto-const, and are wrapped in a constant function. See stdlib::autoconst_v.
+inline function autoconst(const value& v);
+
+/// Create a modifier: A function whose operand derives a new function
+template <typename Derived>
+struct modifier {
+    std::string name;
+
+    value operator()(const value& f) const {
+        return make_function("(" + name + " " + describe(f) + ")", Derived(f));
+    }
+};
+
+/// Create a combinator: A function whose two operands derive a new function
+template <typename Derived>
+struct combinator {
+    std::string name;
+
+    value operator()(const value& f, const value& g) const {
+        return make_function("(" + describe(f) + " " + name + " " + describe(g) + ")",
+                             Derived(f, g));
+    }
+};
+
+/// Constant "˙": Always returns the operand
+struct const_fn {
+    value _value;
+
+    explicit const_fn(const value& v)
+        : _value(v) {}
+
+    value operator()(const value&) const { return _value; }
+    value operator()(const value&, const value&) const { return _value; }
+};
+
+inline function autoconst(const value& v) {
+    if (v.holds<function>()) {
+        return v.get<function>();
+    } else if (v.holds<ast::nothing>()) {
+        throw error("Nothing '·' is not a valid combinator operand");
+    }
+    return make_function("(˙ " + describe(v) + ")", const_fn(v));
+}
+
+/// After "⟜": f(w, g(x)), and f(x, g(x)). The right operand is auto-const.
+struct after {
+    function _after;
+    function _before;
+
+    after(const value& f, const value& g)
+        : _after(f.get<function>())
+        , _before(autoconst(g)) {}
+
+    value operator()(const value& x) const { return _after(x, _before(x)); }
+    value operator()(const value& w, const value& x) const { return _after(w, _before(x)); }
+};
+
+/// Before "⊸": g(f(w), x), and g(f(x), x). The left operand is auto-const.
+struct before {
+    function _before;
+    function _after;
+
+    before(const value& f, const value& g)
+        : _before(autoconst(f))
+        , _after(g.get<function>()) {}
+
+    value operator()(const value& x) const { return _after(_before(x), x); }
+    value operator()(const value& w, const value& x) const { return _after(_before(w), x); }
+};
+
+/// Atop "∘": f(g(w, x)), and f(g(x))
+struct atop {
+    function _f;
+    function _g;
+
+    atop(const value& f, const value& g)
+        : _f(f.get<function>())
+        , _g(g.get<function>()) {}
+
+    value operator()(const value& x) const { return _f(_g(x)); }
+    value operator()(const value& w, const value& x) const { return _f(_g(w, x)); }
+};
+
+/// Over "○": f(g(w), g(x)), and f(g(x))
+struct over {
+    function _f;
+    function _g;
+
+    over(const value& f, const value& g)
+        : _f(f.get<function>())
+        , _g(g.get<function>()) {}
+
+    value operator()(const value& x) const { return _f(_g(x)); }
+    value operator()(const value& w, const value& x) const { return _f(_g(w), _g(x)); }
+};
+
+/// A phi "φ" closure, or "fork": h(f(w, x), g(w, x)), and h(f(x), g(x))
+struct phi {
+    function _f;
+    function _h;
+    function _g;
+
+    value operator()(const value& x) const { return _h(_f(x), _g(x)); }
+    value operator()(const value& w, const value& x) const { return _h(_f(w, x), _g(w, x)); }
+};
+
+/// The intermediate when creating a φ closure. The outer operands are auto-const.
+struct phi_partial {
+    function _h;
+
+    explicit phi_partial(const value& h)
+        : _h(h.get<function>()) {}
+
+    value operator()(const value& f, const value& g) const {
+        return make_function("(" + describe(f) + " φ" + _h.impl().name() + " " + describe(g)
+                                 + ")",
+                             phi{autoconst(f), _h, autoconst(g)});
+    }
+};
+
+/// Self/swap "˜": f(x, w), and f(x, x)
+struct self_swap {
+    function _f;
+
+    explicit self_swap(const value& f)
+        : _f(f.get<function>()) {}
+
+    value operator()(const value& x) const { return _f(x, x); }
+    value operator()(const value& w, const value& x) const { return _f(x, w); }
+};
+
+/// Valences "⊘": Call f monadically, or g dyadically
+struct valences {
+    function _f;
+    function _g;
+
+    valences(const value& f, const value& g)
+        : _f(f.get<function>())
+        , _g(g.get<function>()) {}
+
+    value operator()(const value& x) const { return _f(x); }
+    value operator()(const value& w, const value& x) const { return _g(w, x); }
+};
+
+/// Over-each "¨": Apply f to each element of an array
+struct over_each {
+    function _fn;
+
+    explicit over_each(const value& f)
+        : _fn(f.get<function>()) {}
+
+    value operator()(const value& x) const {
+        auto& in = x.get<array>();
+        array out;
+        out.reserve(in.size());
+        for (auto& el : in) {
+            out.push_back(_fn(el));
+        }
+        return out;
+    }
+};
+
+/**
+ * @brief Fold "/"
+ *
+ * The statically-typed fold finds the identity element using the static type of the range
+ * elements, which is not known here. Instead, the identity comes from the runtime function. If
+ * the function has no identity, a monadic fold begins with the first element.
+ */
+struct fold {
+    function _fn;
+
+    explicit fold(const value& f)
+        : _fn(f.get<function>()) {}
+
+    // Obtain the initial value for a monadic fold, and the number of elements that it consumed
+    std::pair<value, std::size_t> _init(const array& in) const {
+        if (auto id = _fn.impl().identity()) {
+            return {NEO_MOVE(*id), 0};
+        } else if (in.empty()) {
+            throw error("'" + _fn.impl().name()
+                        + "' has no identity element, and cannot fold an empty array");
+        }
+        return {in.front(), 1};
+    }
+
+    value _run(value acc, const array& in, std::size_t offset) const {
+        for (auto i = offset; i < in.size(); ++i) {
+            acc = _fn(acc, in[i]);
+        }
+        return acc;
+    }
+
+    value operator()(const value& x) const {
+        auto& in           = x.get<array>();
+        auto [acc, offset] = _init(in);
+        return _run(NEO_MOVE(acc), in, offset);
+    }
+
+    value operator()(const value& init, const value& x) const {
+        return _run(init, x.get<array>(), 0);
+    }
+};
+
+/// Scan "\": Produces every intermediate result of a fold
+struct scan : fold {
+    using fold::fold;
+
+    array _run(value acc, const array& in, std::size_t offset, array out) const {
+        for (auto i = offset; i < in.size(); ++i) {
+            acc = _fn(acc, in[i]);
+            out.push_back(acc);
+        }
+        return out;
+    }
+
+    value operator()(const value& x) const {
+        auto& in           = x.get<array>();
+        auto [acc, offset] = _init(in);
+        array out;
+        out.reserve(in.size());
+        if (offset) {
+            out.push_back(acc);
+        }
+        return _run(NEO_MOVE(acc), in, offset, NEO_MOVE(out));
+    }
+
+    value operator()(const value& init, const value& x) const {
+        auto& in = x.get<array>();
+        array out;
+        out.reserve(in.size());
+        return _run(init, in, 0, NEO_MOVE(out));
+    }
+};
+
+}  // namespace comb_detail
+
+}  // namespace lmno::rt
@@ -0,0 +1,567 @@
+#pragma once
+
+#include "./column.hpp"
+#include "./parse.hpp"
+#include "./value.hpp"
+
+#include "../error.hpp"
+#include "../stdlib/arithmetic.hpp"
+#include "../stdlib/kernel.hpp"
+#include "../stdlib/logic.hpp"
+#include "../stdlib/numeric.hpp"
+
+#include <neo/fwd.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/**
+ * The array engine: An evaluation mode for runtime programs that operates on whole columns of
+ * integers at a time, rather than on one value at a time.
+ *
+ * In the engine, the primitive functions are pervasive: Applied to a column, they apply to every
+ * element with a single tight loop (a "kernel") that the compiler can vectorize. A scalar operand
+ * is extended to the length of the other column. Intermediate columns are obtained from a
+ * buffer_pool, and a kernel writes its result over a temporary operand when nothing else refers
+ * to it.
+ *
+ * Only integers are supported. Like the fold and scan kernels, integer arithmetic wraps on
+ * overflow.
+ */
+
+namespace lmno::rt {
+
+/// The result of an array program: A scalar or a column
+using array_result = std::variant<std::int64_t, column>;
+
+namespace engine_detail {
+
+using i64 = std::int64_t;
+
+/// Apply the integer binop Fn elementwise
+template <auto Fn>
+struct dyadic {
+    static i64 scalar(i64 w, i64 x) noexcept { return static_cast<i64>(Fn(w, x)); }
+
+    static void columns(const i64* w, const i64* x, i64* out, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = scalar(w[i], x[i]);
+        }
+    }
+
+    static void left_scalar(i64 w, const i64* x, i64* out, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = scalar(w, x[i]);
+        }
+    }
+
+    static void right_scalar(const i64* w, i64 x, i64* out, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = scalar(w[i], x);
+        }
+    }
+};
+
+/// Apply the integer function Fn elementwise
+template <auto Fn>
+struct monadic {
+    static i64 scalar(i64 x) noexcept { return static_cast<i64>(Fn(x)); }
+
+    static void column(const i64* x, i64* out, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = scalar(x[i]);
+        }
+    }
+};
+
+/// Fold and scan with the stdlib function Func, using the multi-accumulator kernels when the
+/// function is associative.
+template <typename Func, auto Fn>
+struct reduction {
+    static i64 reduce(i64 init, const i64* in, std::size_t n) noexcept {
+        if constexpr (stdlib::kernel::op_traits<Func>::associative) {
+            return stdlib::kernel::reduce<Func>(init, in, n);
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                init = dyadic<Fn>::scalar(init, in[i]);
+            }
+            return init;
+        }
+    }
+
+    static i64 scan(i64 init, const i64* in, std::size_t n, i64* out) noexcept {
+        if constexpr (stdlib::kernel::op_traits<Func>::associative) {
+            return stdlib::kernel::scan<Func>(init, in, n, out);
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = init = dyadic<Fn>::scalar(init, in[i]);
+            }
+            return init;
+        }
+    }
+
+    static std::optional<i64> identity() noexcept {
+        if constexpr (non_error<decltype(stdlib::identity_element<i64, Func>)>) {
+            return static_cast<i64>(stdlib::identity_element<i64, Func>);
+        } else {
+            return std::nullopt;
+        }
+    }
+};
+
+/**
+ * @brief A primitive function that the engine can apply to columns. Missing valences are null.
+ */
+struct primitive {
+    std::string_view name;
+
+    i64 (*scalar1)(i64)                            = nullptr;
+    void (*column1)(const i64*, i64*, std::size_t) = nullptr;
+
+    i64 (*scalar2)(i64, i64)                                    = nullptr;
+    void (*columns2)(const i64*, const i64*, i64*, std::size_t) = nullptr;
+    void (*left_scalar2)(i64, const i64*, i64*, std::size_t)    = nullptr;
+    void (*right_scalar2)(const i64*, i64, i64*, std::size_t)   = nullptr;
+
+    i64 (*reduce)(i64, const i64*, std::size_t)     = nullptr;
+    i64 (*scan)(i64, const i64*, std::size_t, i64*) = nullptr;
+    std::optional<i64> identity                     = std::nullopt;
+};
+
+template <auto Fn>
+primitive with_monadic(primitive p) {
+    p.scalar1 = &monadic<Fn>::scalar;
+    p.column1 = &monadic<Fn>::column;
+    return p;
+}
+
+template <typename Func, auto Fn>
+primitive with_dyadic(primitive p) {
+    using dy        = dyadic<Fn>;
+    using red       = reduction<Func, Fn>;
+    p.scalar2       = &dy::scalar;
+    p.columns2      = &dy::columns;
+    p.left_scalar2  = &dy::left_scalar;
+    p.right_scalar2 = &dy::right_scalar;
+    p.reduce        = &red::reduce;
+    p.scan          = &red::scan;
+    p.identity      = red::identity();
+    return p;
+}
+
+// Arithmetic is done in the unsigned domain, so that it wraps rather than overflows
+template <typename Func>
+constexpr inline auto wrapping = [](i64 w, i64 x) noexcept {
+    return stdlib::kernel::op_traits<Func>::apply(w, x);
+};
+
+constexpr inline auto wrapping_minus = [](i64 w, i64 x) noexcept {
+    return static_cast<i64>(static_cast<std::uint64_t>(w) - static_cast<std::uint64_t>(x));
+};
+
+constexpr inline auto wrapping_negate = [](i64 x) noexcept { return wrapping_minus(0, x); };
+
+/// The primitives that the engine can apply to columns
+inline const std::vector<primitive>& primitives() {
+    static const std::vector<primitive> prims = [] {
+        using namespace stdlib;
+        std::vector<primitive> ret;
+        ret.push_back(with_dyadic<plus, wrapping<plus>>({"+"}));
+        ret.push_back(with_dyadic<minus_or_negative, wrapping_minus>(
+            with_monadic<wrapping_negate>({"-"})));
+        ret.push_back(with_dyadic<times_or_sign, wrapping<times_or_sign>>(
+            with_monadic<sign>({"×"})));
+        ret.push_back(with_dyadic<max_or_ceil, wrapping<max_or_ceil>>({"⌈"}));
+        ret.push_back(with_dyadic<min_or_floor, wrapping<min_or_floor>>({"⌊"}));
+        ret.push_back(with_monadic<stdlib::abs>({"|"}));
+        ret.push_back(with_dyadic<equal, _eq>({"="}));
+        ret.push_back(with_dyadic<not_equal, _neq>({"≠"}));
+        ret.push_back(with_dyadic<less, _lt>({"<"}));
+        ret.push_back(with_dyadic<less_equal, _lte>({"≤"}));
+        ret.push_back(with_dyadic<greater, _gt>({">"}));
+        ret.push_back(with_dyadic<greater_equal, _gte>({"≥"}));
+        ret.push_back(with_dyadic<and_, _and>({"∧"}));
+        ret.push_back(with_dyadic<or_, _or>({"∨"}));
+        ret.push_back(with_monadic<_not>({"¬"}));
+        return ret;
+    }();
+    return prims;
+}
+
+struct block_fn;
+
+/// A primitive function
+struct prim_fn {
+    const primitive* prim;
+};
+
+/// A fold "/" or scan "\" modifier, or the function that it derives from a primitive
+struct reduce_fn {
+    bool             is_scan;
+    const primitive* prim = nullptr;
+};
+
+/// Iota "⍳": Generate a column
+struct iota_fn {};
+
+using operand = std::variant<ast::nothing,
+                             i64,
+                             column,
+                             prim_fn,
+                             reduce_fn,
+                             iota_fn,
+                             std::shared_ptr<const block_fn>>;
+
+/// The local names in scope. Later bindings shadow earlier ones.
+using scope = std::vector<std::pair<std::uint32_t, operand>>;
+
+/// A function block, and the names that it captured
+struct block_fn {
+    const syntax_node* body;
+    scope              bound;
+};
+
+/**
+ * @brief The syntax tree of an array program, and the resolution of each name that the engine
+ * defines.
+ */
+struct program_data {
+    syntax_tree                         tree;
+    std::vector<std::optional<operand>> globals;
+    std::int64_t                        alpha = -1;
+    std::int64_t                        omega = -1;
+    /// The function that the program evaluated to
+    operand fn;
+};
+
+inline std::optional<operand> find_global(std::string_view name) {
+    for (auto& p : primitives()) {
+        if (p.name == name) {
+            return prim_fn{&p};
+        }
+    }
+    if (name == "/" or name == "\\") {
+        return reduce_fn{name == "\\"};
+    } else if (name == "⍳") {
+        return iota_fn{};
+    }
+    return std::nullopt;
+}
+
+inline std::string_view type_name(const operand& o) noexcept {
+    switch (o.index()) {
+    case 0:
+        return "nothing";
+    case 1:
+        return "integer";
+    case 2:
+        return "column";
+    default:
+        return "function";
+    }
+}
+
+/**
+ * @brief Evaluates a program with the array engine. The evaluation order matches the runtime
+ * interpreter.
+ */
+struct evaluator {
+    const program_data& prog;
+    buffer_pool&        pool;
+
+    const syntax_tree& tree() const noexcept { return prog.tree; }
+
+    operand lookup(const scope& sc, std::uint32_t name) const {
+        for (auto it = sc.rbegin(); it != sc.rend(); ++it) {
+            if (it->first == name) {
+                return it->second;
+            }
+        }
+        if (auto& g = prog.globals[name]) {
+            return *g;
+        }
+        throw error("The name '" + tree().names[name] + "' is not defined by the array engine");
+    }
+
+    // Obtain a buffer for a result of `n` elements. Reuses the buffer of a temporary operand.
+    std::shared_ptr<column::buffer> output(std::size_t n, const column* a, const column* b) {
+        for (auto c : {a, b}) {
+            if (c) {
+                if (auto buf = c->writable()) {
+                    return *buf;
+                }
+            }
+        }
+        return pool.acquire(n);
+    }
+
+    static const column* as_column(const operand& o) noexcept { return std::get_if<column>(&o); }
+
+    static i64 as_scalar(const operand& o, std::string_view what) {
+        if (auto i = std::get_if<i64>(&o)) {
+            return *i;
+        }
+        throw error("The " + std::string(what) + " must be an integer, but got a value of type '"
+                    + std::string(type_name(o)) + "'");
+    }
+
+    static const column& as_column(const operand& o, std::string_view what) {
+        if (auto c = as_column(o)) {
+            return *c;
+        }
+        throw error("The " + std::string(what) + " must be a column, but got a value of type '"
+                    + std::string(type_name(o)) + "'");
+    }
+
+    operand apply_prim(const primitive& p, const operand& x) {
+        if (not p.scalar1) {
+            throw error("'" + std::string(p.name) + "' is not prefix-invocable");
+        }
+        if (auto c = as_column(x)) {
+            auto out = output(c->size(), c, nullptr);
+            p.column1(c->data(), out->data(), c->size());
+            return column(NEO_MOVE(out));
+        }
+        return p.scalar1(as_scalar(x, "operand of '" + std::string(p.name) + "'"));
+    }
+
+    operand apply_prim(const primitive& p, const operand& w, const operand& x) {
+        if (not p.scalar2) {
+            throw error("'" + std::string(p.name) + "' is not infix-invocable");
+        }
+        auto cw = as_column(w);
+        auto cx = as_column(x);
+        if (cw and cx) {
+            if (cw->size() != cx->size()) {
+                throw error("Column lengths do not agree (" + std::to_string(cw->size())
+                            + " and " + std::to_string(cx->size()) + ")");
+            }
+            auto out = output(cx->size(), cw, cx);
+            p.columns2(cw->data(), cx->data(), out->data(), cx->size());
+            return column(NEO_MOVE(out));
+        }
+        auto what = "operand of '" + std::string(p.name) + "'";
+        if (cx) {
+            auto out = output(cx->size(), cx, nullptr);
+            p.left_scalar2(as_scalar(w, what), cx->data(), out->data(), cx->size());
+            return column(NEO_MOVE(out));
+        } else if (cw) {
+            auto out = output(cw->size(), cw, nullptr);
+            p.right_scalar2(cw->data(), as_scalar(x, what), out->data(), cw->size());
+            return column(NEO_MOVE(out));
+        }
+        return p.scalar2(as_scalar(w, what), as_scalar(x, what));
+    }
+
+    operand apply_reduce(const reduce_fn& r, const std::optional<i64>& given_init,
+                         const operand& x) {
+        auto& p    = *r.prim;
+        auto& in   = as_column(x, "operand of '" + std::string(r.is_scan ? "\\" : "/") + "'");
+        auto  init = given_init ? given_init : p.identity;
+        // Without an initial value, begin with the first element
+        std::size_t offset = 0;
+        if (not init) {
+            if (in.size() == 0) {
+                throw error("'" + std::string(p.name)
+                            + "' has no identity element, and cannot fold an empty column");
+            }
+            init   = in[0];
+            offset = 1;
+        }
+        if (not r.is_scan) {
+            return p.reduce(*init, in.data() + offset, in.size() - offset);
+        }
+        auto out = output(in.size(), &in, nullptr);
+        if (offset) {
+            (*out)[0] = *init;
+        }
+        p.scan(*init, in.data() + offset, in.size() - offset, out->data() + offset);
+        return column(NEO_MOVE(out));
+    }
+
+    operand call_block(const block_fn& blk, operand w, operand x) {
+        scope inner = blk.bound;
+        if (prog.alpha >= 0) {
+            inner.emplace_back(static_cast<std::uint32_t>(prog.alpha), NEO_MOVE(w));
+        }
+        if (prog.omega >= 0) {
+            inner.emplace_back(static_cast<std::uint32_t>(prog.omega), NEO_MOVE(x));
+        }
+        return this->evaluate(inner, *blk.body);
+    }
+
+    operand call(const operand& fn, operand x) {
+        if (auto p = std::get_if<prim_fn>(&fn)) {
+            return apply_prim(*p->prim, x);
+        } else if (auto r = std::get_if<reduce_fn>(&fn)) {
+            if (not r->prim) {
+                // Apply the modifier to its operand
+                auto f = std::get_if<prim_fn>(&x);
+                if (not f or not f->prim->scalar2) {
+                    throw error("The operand of a fold or scan must be a dyadic primitive");
+                }
+                return reduce_fn{r->is_scan, f->prim};
+            }
+            return apply_reduce(*r, std::nullopt, x);
+        } else if (std::holds_alternative<iota_fn>(fn)) {
+            auto n = as_scalar(x, "operand of '⍳'");
+            auto out = pool.acquire(static_cast<std::size_t>(n < 0 ? 0 : n));
+            for (std::size_t i = 0; i < out->size(); ++i) {
+                (*out)[i] = static_cast<i64>(i);
+            }
+            return column(NEO_MOVE(out));
+        } else if (auto b = std::get_if<std::shared_ptr<const block_fn>>(&fn)) {
+            return call_block(**b, ast::nothing{}, NEO_MOVE(x));
+        }
+        throw error("A value of type '" + std::string(type_name(fn)) + "' is not invocable");
+    }
+
+    operand call(const operand& fn, operand w, operand x) {
+        if (auto p = std::get_if<prim_fn>(&fn)) {
+            return apply_prim(*p->prim, w, x);
+        } else if (auto r = std::get_if<reduce_fn>(&fn); r and r->prim) {
+            return apply_reduce(*r, as_scalar(w, "initial value of a fold"), x);
+        } else if (auto b = std::get_if<std::shared_ptr<const block_fn>>(&fn)) {
+            return call_block(**b, NEO_MOVE(w), NEO_MOVE(x));
+        }
+        throw error("A value of type '" + std::string(type_name(fn))
+                    + "' is not infix-invocable");
+    }
+
+    operand evaluate(scope& sc, const syntax_node& n) {
+        switch (n.kind) {
+        case node_kind::nothing:
+            return ast::nothing{};
+        case node_kind::constant:
+            return tree().constants[n.first];
+        case node_kind::name:
+            return lookup(sc, n.first);
+        case node_kind::monad: {
+            auto fn    = this->evaluate(sc, tree().child(n, 0));
+            auto right = this->evaluate(sc, tree().child(n, 1));
+            return this->call(fn, NEO_MOVE(right));
+        }
+        case node_kind::dyad: {
+            auto& w = tree().child(n, 0);
+            if (w.kind == node_kind::nothing) {
+                // A dyad with "·" on the left is a monadic invocation
+                auto fn    = this->evaluate(sc, tree().child(n, 1));
+                auto right = this->evaluate(sc, tree().child(n, 2));
+                return this->call(fn, NEO_MOVE(right));
+            }
+            auto left  = this->evaluate(sc, w);
+            auto fn    = this->evaluate(sc, tree().child(n, 1));
+            auto right = this->evaluate(sc, tree().child(n, 2));
+            return this->call(fn, NEO_MOVE(left), NEO_MOVE(right));
+        }
+        case node_kind::block:
+            return std::make_shared<const block_fn>(block_fn{&tree().child(n, 0), sc});
+        case node_kind::assignment:
+            // A lone assignment, with no subsequent statements. The name goes nowhere.
+            return this->evaluate(sc, tree().child(n, 1));
+        case node_kind::strand: {
+            // A strand of integers is a column
+            auto out = pool.acquire(n.count);
+            for (std::uint32_t i = 0; i < n.count; ++i) {
+                (*out)[i] = as_scalar(this->evaluate(sc, tree().child(n, i)), "strand element");
+            }
+            return column(NEO_MOVE(out));
+        }
+        case node_kind::stmt_seq: {
+            const auto n_bound = sc.size();
+            for (std::uint32_t i = 0; i + 1 < n.count; ++i) {
+                auto& stmt = tree().child(n, i);
+                if (stmt.kind == node_kind::assignment) {
+                    // Bind the name for the subsequent statements
+                    auto val = this->evaluate(sc, tree().child(stmt, 1));
+                    sc.emplace_back(tree().child(stmt, 0).first, NEO_MOVE(val));
+                } else {
+                    this->evaluate(sc, stmt);
+                }
+            }
+            auto ret = this->evaluate(sc, tree().child(n, n.count - 1));
+            sc.resize(n_bound);
+            return ret;
+        }
+        }
+        throw error("Invalid syntax tree");
+    }
+};
+
+inline array_result to_result(operand o) {
+    if (auto i = std::get_if<i64>(&o)) {
+        return *i;
+    } else if (auto c = std::get_if<column>(&o)) {
+        return NEO_MOVE(*c);
+    }
+    throw error("The result of an array program must be an integer or a column, but got a value "
+                "of type '"
+                + std::string(type_name(o)) + "'");
+}
+
+}  // namespace engine_detail
+
+/**
+ * @brief A runtime-compiled lmno function that is evaluated with the array engine.
+ *
+ * Results are obtained from the calling thread's buffer_pool. A result may also be a view of an
+ * argument, e.g. for "{ω}".
+ */
+class array_program {
+    std::shared_ptr<const engine_detail::program_data> _data;
+
+public:
+    explicit array_program(std::shared_ptr<const engine_detail::program_data> data) noexcept
+        : _data(NEO_MOVE(data)) {}
+
+    /// Apply the program's function to a column
+    array_result operator()(std::span<const std::int64_t> x) const {
+        engine_detail::evaluator ev{*_data, buffer_pool::current()};
+        return engine_detail::to_result(ev.call(_data->fn, column::view(x)));
+    }
+
+    /// Apply the program's function to two columns
+    array_result operator()(std::span<const std::int64_t> w,
+                            std::span<const std::int64_t> x) const {
+        engine_detail::evaluator ev{*_data, buffer_pool::current()};
+        return engine_detail::to_result(ev.call(_data->fn, column::view(w), column::view(x)));
+    }
+};
+
+/**
+ * @brief Compile lmno code for evaluation with the array engine.
+ *
+ * The code must evaluate to a function, which is applied to columns. The engine defines integer
+ * constants and strands, names, function blocks, the primitives + - × ⌈ ⌊ | = ≠ < ≤ > ≥ ∧ ∨ ¬
+ * and ⍳, and fold "/" and scan "\" of the dyadic primitives.
+ *
+ * @param code The code to compile
+ * @throws rt::error if the code is malformed, or does not evaluate to a function
+ */
+inline array_program compile_array(std::string_view code) {
+    auto data   = std::make_shared<engine_detail::program_data>();
+    data->tree  = rt::parse(code);
+    data->alpha = data->tree.find_name("α");
+    data->omega = data->tree.find_name("ω");
+    for (auto& name : data->tree.names) {
+        data->globals.push_back(engine_detail::find_global(name));
+    }
+    engine_detail::scope     top;
+    engine_detail::evaluator ev{*data, buffer_pool::current()};
+    data->fn = ev.evaluate(top, data->tree.nodes[data->tree.root]);
+    auto idx = data->fn.index();
+    if (idx < 3) {
+        throw error("An array program must evaluate to a function, but got a value of type '"
+                    + std::string(engine_detail::type_name(data->fn)) + "'");
+    }
+    return array_program{NEO_MOVE(data)};
+}
+
+}  // namespace lmno::rt
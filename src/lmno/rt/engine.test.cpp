@@ -0,0 +1,106 @@
+#include "./engine.hpp"
+
+#include "./interp.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+namespace rt = lmno::rt;
+using i64    = std::int64_t;
+
+namespace {
+
+std::vector<i64> to_vector(const rt::array_result& r) {
+    auto& col = std::get<rt::column>(r);
+    return std::vector<i64>(col.begin(), col.end());
+}
+
+i64 to_scalar(const rt::array_result& r) { return std::get<i64>(r); }
+
+}  // namespace
+
+TEST_CASE("Apply primitives to columns") {
+    const std::vector<i64> x = {1, -2, 3, 4};
+    const std::vector<i64> w = {4, 3, 2, 1};
+    CHECK(to_vector(rt::compile_array("{ω}")(x)) == x);
+    CHECK(to_vector(rt::compile_array("-")(x)) == std::vector<i64>{-1, 2, -3, -4});
+    CHECK(to_vector(rt::compile_array("|")(x)) == std::vector<i64>{1, 2, 3, 4});
+    CHECK(to_vector(rt::compile_array("×")(x)) == std::vector<i64>{1, -1, 1, 1});
+    CHECK(to_vector(rt::compile_array("+")(w, x)) == std::vector<i64>{5, 1, 5, 5});
+    CHECK(to_vector(rt::compile_array("⌈")(w, x)) == std::vector<i64>{4, 3, 3, 4});
+    CHECK(to_vector(rt::compile_array("<")(w, x)) == std::vector<i64>{0, 0, 1, 1});
+    CHECK(to_vector(rt::compile_array("{¬ω>2}")(x)) == std::vector<i64>{1, 1, 0, 0});
+    // Scalars extend to the length of the column
+    CHECK(to_vector(rt::compile_array("{(ω×ω)+1}")(x)) == std::vector<i64>{2, 5, 10, 17});
+    CHECK(to_vector(rt::compile_array("{2-ω}")(x)) == std::vector<i64>{1, 4, -1, -2});
+    CHECK(to_vector(rt::compile_array("{(α=2)∨ω=4}")(w, x))
+          == std::vector<i64>{0, 0, 1, 1});
+    CHECK(to_vector(rt::compile_array("{ω + 1‿2‿3‿4}")(x)) == std::vector<i64>{2, 0, 6, 8});
+
+    CHECK_THROWS_AS(rt::compile_array("+")(x, std::vector<i64>{1, 2}), rt::error);
+    CHECK_THROWS_AS(rt::compile_array("=")(x), rt::error);
+    CHECK_THROWS_AS(rt::compile_array("{ω ÷ 2}")(x), rt::error);
+    CHECK_THROWS_AS(rt::compile_array("1 + 2"), rt::error);
+}
+
+TEST_CASE("Fold and scan columns") {
+    std::vector<i64> x(1000);
+    std::iota(x.begin(), x.end(), i64(1));
+    CHECK(to_scalar(rt::compile_array("/:+")(x)) == 500500);
+    CHECK(to_scalar(rt::compile_array("{/:+ $ ω×2}")(x)) == 1001000);
+    CHECK(to_scalar(rt::compile_array("{/:⌈ $ ω}")(x)) == 1000);
+    CHECK(to_scalar(rt::compile_array("{/:∧ $ ω>0}")(x)) == 1);
+    CHECK(to_scalar(rt::compile_array("{/:+ $ ω>500}")(x)) == 500);
+    CHECK(to_scalar(rt::compile_array("{/:+ $ ⍳ (/:+ $ ω)}")(std::vector<i64>{2, 3})) == 10);
+
+    auto sums = to_vector(rt::compile_array("\\:+")(x));
+    REQUIRE(sums.size() == 1000);
+    CHECK(sums.front() == 1);
+    CHECK(sums.back() == 500500);
+    // Without an identity element, begins with the first element
+    CHECK(to_vector(rt::compile_array("\\:<")(std::vector<i64>{3, 1, 2}))
+          == std::vector<i64>{3, 0, 1});
+    CHECK_THROWS_AS(rt::compile_array("/:<")(std::vector<i64>{}), rt::error);
+}
+
+TEST_CASE("The array engine agrees with the runtime interpreter") {
+    const std::vector<i64> x = {3, 1, 4, 1, 5, 9, 2, 6};
+    rt::array arr;
+    for (auto v : x) {
+        arr.push_back(v);
+    }
+    auto code = GENERATE(as<std::string_view>{},
+                         "/:+",
+                         "/:⌊",
+                         "{/:+ $ ¨:{ω × ω} ω}",
+                         "{x ← /:+ $ ω; x × 2}",
+                         "{f ← {ω + 1}; /:+ $ ¨:f ω}");
+    INFO(code);
+    auto scalar_code = std::string(code);
+    // The engine applies primitives pervasively, so "¨:" is not needed
+    for (auto pos = scalar_code.find("¨:"); pos != std::string::npos;
+         pos      = scalar_code.find("¨:")) {
+        scalar_code.erase(pos, std::string_view("¨:").size());
+    }
+    auto expect = rt::eval(code).get<rt::function>()(arr);
+    CHECK(rt::value(to_scalar(rt::compile_array(scalar_code)(x))) == expect);
+}
+
+TEST_CASE("Intermediate columns are pooled") {
+    std::vector<i64> x(256, 3);
+    auto             prog = rt::compile_array("{a ← ω × ω; b ← a + ω; (b - a) × 2}");
+    auto&            pool = rt::buffer_pool::current();
+    pool.trim();
+    CHECK(to_vector(prog(x)) == std::vector<i64>(256, 6));
+    auto n_buffers = pool.size();
+    for (int i = 0; i < 10; ++i) {
+        CHECK(to_vector(prog(x)) == std::vector<i64>(256, 6));
+    }
+    // Repeated evaluation reuses the same buffers
+    CHECK(pool.size() == n_buffers);
+    CHECK(n_buffers <= 3);
+}
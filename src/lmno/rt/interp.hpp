@@ -0,0 +1,224 @@
+#pragma once
+
+#include "./parse.hpp"
+#include "./registry.hpp"
+#include "./value.hpp"
+
+#include <neo/fwd.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lmno::rt {
+
+namespace interp_detail {
+
+/**
+ * @brief A compiled program: The syntax tree, and the resolution of each of the names in the tree
+ * that are defined in the registry.
+ */
+struct program_data {
+    syntax_tree                       tree;
+    std::vector<std::optional<value>> globals;
+    std::int64_t                      alpha = -1;
+    std::int64_t                      omega = -1;
+};
+
+/**
+ * @brief A local name binding. Bindings form an immutable linked list that can be shared by
+ * closures.
+ */
+struct binding {
+    std::uint32_t                  name;
+    value                          val;
+    std::shared_ptr<const binding> next;
+};
+
+using scope = std::shared_ptr<const binding>;
+
+inline scope push_binding(scope parent, std::int64_t name, value v) {
+    if (name < 0) {
+        // The name is never referenced, so we don't need to bind it.
+        return parent;
+    }
+    return std::make_shared<const binding>(
+        binding{static_cast<std::uint32_t>(name), NEO_MOVE(v), NEO_MOVE(parent)});
+}
+
+/**
+ * @brief The runtime counterpart of lmno::default_sema.
+ */
+struct evaluator {
+    const std::shared_ptr<const program_data>& prog;
+
+    const syntax_tree& tree() const noexcept { return prog->tree; }
+
+    value evaluate(const scope& sc, const syntax_node& n) const;
+
+    const value& lookup(const scope& sc, std::uint32_t name) const {
+        for (auto b = sc.get(); b; b = b->next.get()) {
+            if (b->name == name) {
+                return b->val;
+            }
+        }
+        if (auto& g = prog->globals[name]) {
+            return *g;
+        }
+        throw error("The name '" + tree().names[name] + "' is not defined");
+    }
+
+    static const function& as_function(const value& fn) {
+        if (not fn.holds<function>()) {
+            throw error("A value of type '" + std::string(fn.type_name())
+                        + "' is not invocable");
+        }
+        return fn.get<function>();
+    }
+
+    value evaluate_stmts(scope sc, const syntax_node& seq) const {
+        for (std::uint32_t i = 0; i + 1 < seq.count; ++i) {
+            auto& stmt = tree().child(seq, i);
+            if (stmt.kind == node_kind::assignment) {
+                // Bind the name for the subsequent statements
+                auto& id = tree().child(stmt, 0);
+                sc       = push_binding(sc, id.first, this->evaluate(sc, tree().child(stmt, 1)));
+            } else {
+                this->evaluate(sc, stmt);
+            }
+        }
+        return this->evaluate(sc, tree().child(seq, seq.count - 1));
+    }
+};
+
+/**
+ * @brief A closure object generated from a function block, capturing the names of the enclosing
+ * scope
+ */
+class closure : public function_impl {
+    std::shared_ptr<const program_data> _prog;
+    const syntax_node*                  _code;
+    scope                               _bound;
+
+public:
+    closure(std::shared_ptr<const program_data> prog, const syntax_node& code, scope bound)
+        : _prog(NEO_MOVE(prog))
+        , _code(&code)
+        , _bound(NEO_MOVE(bound)) {}
+
+    std::string name() const override { return "(closure)"; }
+
+    value call(const value& x) const override {
+        auto with_w = push_binding(_bound, _prog->alpha, ast::nothing{});
+        auto inner  = push_binding(NEO_MOVE(with_w), _prog->omega, x);
+        return evaluator{_prog}.evaluate(inner, *_code);
+    }
+
+    value call(const value& w, const value& x) const override {
+        auto with_w = push_binding(_bound, _prog->alpha, w);
+        auto inner  = push_binding(NEO_MOVE(with_w), _prog->omega, x);
+        return evaluator{_prog}.evaluate(inner, *_code);
+    }
+};
+
+inline value evaluator::evaluate(const scope& sc, const syntax_node& n) const {
+    switch (n.kind) {
+    case node_kind::nothing:
+        return ast::nothing{};
+    case node_kind::constant:
+        return tree().constants[n.first];
+    case node_kind::name:
+        return lookup(sc, n.first);
+    case node_kind::monad: {
+        auto fn    = this->evaluate(sc, tree().child(n, 0));
+        auto right = this->evaluate(sc, tree().child(n, 1));
+        return as_function(fn)(right);
+    }
+    case node_kind::dyad: {
+        auto& w = tree().child(n, 0);
+        if (w.kind == node_kind::nothing) {
+            // A dyad with "·" on the left is a monadic invocation
+            auto fn    = this->evaluate(sc, tree().child(n, 1));
+            auto right = this->evaluate(sc, tree().child(n, 2));
+            return as_function(fn)(right);
+        }
+        auto left  = this->evaluate(sc, w);
+        auto fn    = this->evaluate(sc, tree().child(n, 1));
+        auto right = this->evaluate(sc, tree().child(n, 2));
+        return as_function(fn)(left, right);
+    }
+    case node_kind::block:
+        return function(std::make_shared<const closure>(prog, tree().child(n, 0), sc));
+    case node_kind::assignment:
+        // A lone assignment, with no subsequent statements. The name goes nowhere.
+        return this->evaluate(sc, tree().child(n, 1));
+    case node_kind::strand: {
+        array arr;
+        arr.reserve(n.count);
+        for (std::uint32_t i = 0; i < n.count; ++i) {
+            arr.push_back(this->evaluate(sc, tree().child(n, i)));
+        }
+        return arr;
+    }
+    case node_kind::stmt_seq:
+        return this->evaluate_stmts(sc, n);
+    }
+    throw error("Invalid syntax tree");
+}
+
+}  // namespace interp_detail
+
+/**
+ * @brief A runtime-compiled lmno program.
+ *
+ * Programs are immutable and cheap to copy. Functions created by a program keep it alive.
+ */
+class program {
+    std::shared_ptr<const interp_detail::program_data> _data;
+
+public:
+    explicit program(std::shared_ptr<const interp_detail::program_data> data) noexcept
+        : _data(NEO_MOVE(data)) {}
+
+    /// Evaluate the program
+    value operator()() const {
+        return interp_detail::evaluator{_data}.evaluate({}, _data->tree.nodes[_data->tree.root]);
+    }
+};
+
+/**
+ * @brief Compile lmno code at runtime.
+ *
+ * @param code The code to compile
+ * @param reg The registry of names that are visible to the code
+ * @throws rt::error if the code is malformed
+ */
+inline program compile(std::string_view code, const registry& reg = default_registry()) {
+    auto data   = std::make_shared<interp_detail::program_data>();
+    data->tree  = rt::parse(code);
+    data->alpha = data->tree.find_name("α");
+    data->omega = data->tree.find_name("ω");
+    // Resolve the names that are defined in the registry ahead of time. Local bindings may
+    // still shadow them.
+    for (auto& name : data->tree.names) {
+        auto def = reg.find(name);
+        data->globals.push_back(def ? std::optional<value>(*def) : std::nullopt);
+    }
+    return program{NEO_MOVE(data)};
+}
+
+/**
+ * @brief Compile and evaluate lmno code at runtime. Akin to lmno::eval<Code>(), but for code that
+ * is not known at compile time.
+ *
+ * @param code The code to evaluate
+ * @param reg The registry of names that are visible to the code
+ * @throws rt::error if the code is malformed or cannot be evaluated
+ */
+inline value eval(std::string_view code, const registry& reg = default_registry()) {
+    return rt::compile(code, reg)();
+}
+
+}  // namespace lmno::rt
@@ -0,0 +1,115 @@
+#include "./interp.hpp"
+
+#include <lmno/eval.hpp>
+#include <lmno/stdlib.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace rt = lmno::rt;
+using lmno::rational;
+
+namespace {
+
+rt::value arr(auto... vals) { return rt::array{rt::value(vals)...}; }
+
+}  // namespace
+
+TEST_CASE("Parse at runtime") {
+    auto tree = rt::parse("x ← 4; {ω + x} 3‿¯2");
+    auto root = tree.nodes[tree.root];
+    CHECK(root.kind == rt::node_kind::stmt_seq);
+    CHECK(root.count == 2);
+    CHECK(tree.child(root, 0).kind == rt::node_kind::assignment);
+    CHECK(tree.child(root, 1).kind == rt::node_kind::monad);
+    CHECK(tree.constants == std::vector<std::int64_t>{4, 3, -2});
+    CHECK(tree.find_name("x") >= 0);
+    CHECK(tree.find_name("y") == -1);
+
+    CHECK_THROWS_AS(rt::parse(""), rt::error);
+    CHECK_THROWS_AS(rt::parse("(1 + 2"), rt::error);
+    CHECK_THROWS_AS(rt::parse("1 + 2)"), rt::error);
+    CHECK_THROWS_AS(rt::parse("{ω"), rt::error);
+    CHECK_THROWS_AS(rt::parse("1 (: Unterminated"), rt::error);
+    CHECK_THROWS_AS(rt::parse("3 ← 4"), rt::error);
+    CHECK_THROWS_AS(rt::parse("99999999999999999999"), rt::error);
+}
+
+TEST_CASE("Evaluate scalars") {
+    CHECK(rt::eval("3") == 3);
+    CHECK(rt::eval("3+4") == 7);
+    CHECK(rt::eval("¯174") == -174);
+    CHECK(rt::eval("- 4+3") == -7);
+    CHECK(rt::eval("5 - 3") == 2);
+    CHECK(rt::eval("4÷3") == rational{4, 3});
+    CHECK(rt::eval("3 ⌈ 7") == 7);
+    CHECK(rt::eval("2 ^ 10") == 1024);
+    CHECK(rt::eval("1 = 1") == 1);
+    CHECK(rt::eval("1 < 0") == 0);
+    CHECK(rt::eval("·").holds<lmno::ast::nothing>());
+}
+
+TEST_CASE("Evaluate arrays") {
+    CHECK(rt::eval("1‿2‿3") == arr(1, 2, 3));
+    CHECK(rt::eval("⍳4") == arr(0, 1, 2, 3));
+    CHECK(rt::eval("2↓·⍳5") == arr(2, 3, 4));
+    CHECK(rt::eval("3↑·⍳10") == arr(0, 1, 2));
+    CHECK(rt::eval("⌽ 1‿2‿3") == arr(3, 2, 1));
+    CHECK(rt::eval("1‿2 = 1‿2") == 1);
+    CHECK(rt::eval("\\:+ 1‿2‿3") == arr(1, 3, 6));
+    CHECK(rt::eval("¨:{ω×ω} 1‿2‿3") == arr(1, 4, 9));
+}
+
+TEST_CASE("Runtime evaluation agrees with compile-time evaluation") {
+    const auto one_two_three = std::array{1, 2, 3};
+    CHECK(rt::eval("(/:+∘⍳) 6") == rt::to_value(lmno::eval<"/:+∘⍳">()(6)));
+    CHECK(rt::eval("(/:+∘¨:{ω×ω}) 1‿2‿3")
+          == rt::to_value(lmno::eval<"/:+∘¨:{ω×ω}">()(one_two_three)));
+    CHECK(rt::eval("((2⊸×)∘-) 4") == rt::to_value(lmno::eval<"(2⊸×)∘-">()(4)));
+    CHECK(rt::eval("((×⟜2)∘-) 4") == rt::to_value(lmno::eval<"(×⟜2)∘-">()(4)));
+    CHECK(rt::eval("8 (-φ:⌈+) ¯12") == rt::to_value(lmno::eval<"-φ:⌈+">()(8, -12)));
+    CHECK(rt::eval("8 (-φ:⌈˜:-) 12") == rt::to_value(lmno::eval<"-φ:⌈˜:-">()(8, 12)));
+    CHECK(rt::eval("(2⊸^) 8") == rt::to_value(lmno::eval<"2⊸^">()(8)));
+    CHECK(rt::eval("{0⊸·/{α+ω}$⍳ω} 4") == rt::to_value(lmno::eval<"{0⊸·/{α+ω}$⍳ω}">()(4)));
+    CHECK(rt::eval("{{ω}2}0") == rt::to_value(lmno::eval<"{{ω}2}0">()));
+    CHECK(rt::eval("/:+$⍳4") == rt::to_value(lmno::eval<"/:+$⍳4">()));
+    CHECK(rt::eval("1÷3") == rt::to_value(lmno::eval<"1÷3">()));
+}
+
+TEST_CASE("Names and closures") {
+    CHECK(rt::eval("x ← 4; x × x") == 16);
+    CHECK(rt::eval("f ← {ω + 1}; f 41") == 42);
+    CHECK(rt::eval("2 {α × ω} 21") == 42);
+    // Closures capture the bindings at the point they are created
+    CHECK(rt::eval("x ← 1; f ← {x + ω}; x ← 10; f 1") == 2);
+    // The registry names may be shadowed
+    CHECK(rt::eval("+ ← -; 3 + 2") == 1);
+
+    rt::registry reg = rt::default_registry();
+    reg.define("limit", 10);
+    CHECK(rt::eval("limit ⌊ 42", reg) == 10);
+
+    // Functions may be called from C++
+    auto square = rt::eval("{ω × ω}").get<rt::function>();
+    CHECK(square(7) == 49);
+    auto sum = rt::eval("/:+").get<rt::function>();
+    CHECK(sum(rt::eval("⍳5")) == 10);
+
+    // Programs may be compiled once and evaluated many times
+    auto prog = rt::compile("/:+ $ ⍳ 100");
+    CHECK(prog() == 4950);
+    CHECK(prog() == 4950);
+}
+
+TEST_CASE("Runtime errors") {
+    CHECK_THROWS_AS(rt::eval("foo"), rt::error);
+    CHECK_THROWS_AS(rt::eval("1 2"), rt::error);
+    CHECK_THROWS_AS(rt::eval("1 + 1‿2"), rt::error);
+    CHECK_THROWS_AS(rt::eval("/:+ 4"), rt::error);
+    CHECK_THROWS_AS(rt::eval("/:{α+ω} $ ⍳0"), rt::error);
+    CHECK_THROWS_AS(rt::eval("3 ÷ 0"), rt::error);
+    CHECK_THROWS_AS(rt::eval("∞"), rt::error);
+}
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "./value.hpp"
+
+#include "../lex.hpp"
+#include "../parse.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lmno::rt {
+
+/**
+ * @brief The kinds of node in a runtime syntax tree. These correspond to the lmno::ast templates.
+ */
+enum class node_kind : std::uint8_t {
+    nothing,
+    constant,
+    name,
+    monad,
+    dyad,
+    block,
+    assignment,
+    strand,
+    stmt_seq,
+};
+
+/**
+ * @brief A node in a runtime syntax tree
+ */
+struct syntax_node {
+    node_kind kind;
+    /// For a name: The index of the name. For a constant: The index of the constant. Otherwise:
+    /// The index of the first child in the children array.
+    std::uint32_t first = 0;
+    /// The number of children of the node
+    std::uint32_t count = 0;
+};
+
+/**
+ * @brief A compact runtime syntax tree. Nodes refer to each other by index rather than by pointer.
+ *
+ * The children of a monad are [F, X], and the children of a dyad are [W, F, X]. The children of
+ * an assignment are [Name, Expr].
+ */
+struct syntax_tree {
+    std::vector<syntax_node>   nodes;
+    std::vector<std::uint32_t> children;
+    std::vector<std::string>   names;
+    std::vector<std::int64_t>  constants;
+    std::uint32_t              root = 0;
+
+    /// Obtain the Nth child of the given node
+    const syntax_node& child(const syntax_node& n, std::uint32_t nth) const noexcept {
+        return nodes[children[n.first + nth]];
+    }
+
+    /// Obtain the index of the given name, or -1 if it does not appear in the tree
+    std::int64_t find_name(std::string_view name) const noexcept {
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name) {
+                return static_cast<std::int64_t>(i);
+            }
+        }
+        return -1;
+    }
+};
+
+namespace tree_detail {
+
+using lmno::parse_detail::node;
+
+/**
+ * @brief Builds a syntax_tree from the parser's node instructions. This is the runtime
+ * counterpart of lmno::parse_detail::executor, and uses the same stack-based algorithm.
+ */
+struct tree_builder {
+    std::string_view               source;
+    syntax_tree                    tree{};
+    std::vector<std::uint32_t>     stack{};
+
+    std::uint32_t push_node(node_kind kind, std::uint32_t first, std::uint32_t count) {
+        tree.nodes.push_back({kind, first, count});
+        return static_cast<std::uint32_t>(tree.nodes.size() - 1);
+    }
+
+    // Create a node whose children are the given node indices
+    template <typename... Children>
+    std::uint32_t push_parent(node_kind kind, Children... ch) {
+        auto first = static_cast<std::uint32_t>(tree.children.size());
+        (tree.children.push_back(ch), ...);
+        return push_node(kind, first, sizeof...(Children));
+    }
+
+    // Pop the top `count` nodes from the stack and make them the children of a new node
+    std::uint32_t pop_parent(node_kind kind, std::uint64_t count) {
+        auto first = static_cast<std::uint32_t>(tree.children.size());
+        auto begin = stack.end() - static_cast<std::ptrdiff_t>(count);
+        tree.children.insert(tree.children.end(), begin, stack.end());
+        stack.erase(begin, stack.end());
+        return push_node(kind, first, static_cast<std::uint32_t>(count));
+    }
+
+    // Get the text of the token at the given encoded range of the source
+    std::string_view token_at(std::uint64_t span) const noexcept {
+        auto r = lmno::parse_detail::decode_span(span);
+        return source.substr(r.pos, r.len);
+    }
+
+    std::uint32_t intern(std::string_view name) {
+        auto idx = tree.find_name(name);
+        if (idx >= 0) {
+            return static_cast<std::uint32_t>(idx);
+        }
+        tree.names.emplace_back(name);
+        return static_cast<std::uint32_t>(tree.names.size() - 1);
+    }
+
+    // Collapse the top `count` nodes into a single prefix/infix expression. See collapse_chain.
+    std::uint32_t collapse_chain(std::uint64_t count) {
+        auto items = std::vector<std::uint32_t>(stack.end() - static_cast<std::ptrdiff_t>(count),
+                                                stack.end());
+        stack.resize(stack.size() - count);
+        auto i   = items.size() - 1;
+        auto acc = items[i];
+        for (; i >= 2; i -= 2) {
+            acc = push_parent(node_kind::dyad, items[i - 2], items[i - 1], acc);
+        }
+        if (i == 1) {
+            acc = push_parent(node_kind::monad, items[0], acc);
+        }
+        return acc;
+    }
+
+    void step(node n) {
+        using namespace lmno::parse_detail;
+        std::uint32_t new_node = 0;
+        switch (n.kind) {
+        case k_nothing:
+            new_node = push_node(node_kind::nothing, 0, 0);
+            break;
+        case k_int:
+            tree.constants.push_back(lmno::parse_detail::parse_int(token_at(n.n)));
+            new_node = push_node(node_kind::constant,
+                                 static_cast<std::uint32_t>(tree.constants.size() - 1),
+                                 0);
+            break;
+        case k_name:
+            new_node = push_node(node_kind::name, intern(token_at(n.n)), 0);
+            break;
+        case k_block_begin:
+            // The nodes of the block follow, and are closed by a k_block
+            return;
+        case k_block: {
+            auto inner = stack.back();
+            stack.pop_back();
+            new_node = push_parent(node_kind::block, inner);
+            break;
+        }
+        case k_train:
+            new_node = collapse_chain(n.n);
+            break;
+        case k_strand:
+            new_node = pop_parent(node_kind::strand, n.n);
+            break;
+        case k_assign:
+            if (tree.nodes[stack[stack.size() - 2]].kind != node_kind::name) {
+                throw error("The left-hand side of an assignment must be a name");
+            }
+            new_node = pop_parent(node_kind::assignment, 2);
+            break;
+        case k_seq:
+            new_node = pop_parent(node_kind::stmt_seq, n.n);
+            break;
+        case k_done:
+            return;
+        }
+        stack.push_back(new_node);
+    }
+};
+
+}  // namespace tree_detail
+
+/**
+ * @brief Tokenize and parse lmno code at runtime, using the same lexer and parser as compile-time
+ * code.
+ *
+ * @param code The code to parse
+ * @return syntax_tree The parsed code
+ * @throws rt::error if the code is malformed
+ */
+inline syntax_tree parse(std::string_view code) {
+    // The lexer expects a null-terminated string. We pad the end with extra nulls so that a
+    // truncated UTF-8 sequence at the end of the input cannot be read past the end.
+    std::string src{code};
+    src.append(4, '\0');
+
+    try {
+        std::vector<lex::detail::token_range> ranges(src.size() + 1);
+        const auto n_tokens = static_cast<std::size_t>(lex::detail::tokenize(ranges.data(),
+                                                                             src.data()));
+        std::vector<lex::token> tokens;
+        tokens.reserve(n_tokens + 1);
+        for (std::size_t i = 0; i < n_tokens; ++i) {
+            if (ranges[i].len > lex::max_token_length) {
+                throw error("Token '" + src.substr(ranges[i].pos, ranges[i].len)
+                            + "' is too long");
+            }
+            tokens.push_back(lex::detail::take_token(src.data(), ranges[i]));
+        }
+        // The parser stops at the empty token
+        tokens.emplace_back();
+
+        std::vector<lmno::parse_detail::node> nodes(tokens.size() * 2);
+        lmno::parse_detail::token_iter        iter{tokens.data(), ranges.data()};
+        auto                                  into = nodes.data();
+        lmno::parse_detail::parser3::parse_top(into, iter);
+        *into = {lmno::parse_detail::k_done, 0};
+        if (iter.pos != n_tokens) {
+            throw error("Unexpected token '" + std::string(std::string_view(iter.get())) + "'");
+        }
+
+        tree_detail::tree_builder builder{src};
+        for (auto it = nodes.data(); it != into; ++it) {
+            builder.step(*it);
+        }
+        builder.tree.root = builder.stack.back();
+        return NEO_MOVE(builder.tree);
+    } catch (const char* message) {
+        throw error(message);
+    }
+}
+
+}  // namespace lmno::rt
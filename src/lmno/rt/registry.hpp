@@ -0,0 +1,113 @@
+#pragma once
+
+#include "./adapt.hpp"
+#include "./comb.hpp"
+#include "./value.hpp"
+
+#include "../define.hpp"
+#include "../lex.hpp"
+#include "../stdlib.hpp"
+
+#include <neo/fwd.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace lmno::rt {
+
+/**
+ * @brief A set of named values that are visible to runtime code
+ */
+class registry {
+    std::map<std::string, value, std::less<>> _defs;
+
+public:
+    /// Define (or redefine) the given name
+    void define(std::string name, value v) { _defs.insert_or_assign(NEO_MOVE(name), NEO_MOVE(v)); }
+
+    /// Define a name using the statically-typed lmno::define<> for that name
+    template <lex::token Name>
+    void define_builtin() {
+        auto name = std::string(std::string_view(Name));
+        using F   = std::remove_cvref_t<decltype(lmno::define<Name>)>;
+        if constexpr (value_convertible<F>) {
+            this->define(name, rt::to_value(lmno::define<Name>));
+        } else {
+            auto fn = std::make_shared<const callable<F>>(lmno::define<Name>, name);
+            this->define(NEO_MOVE(name), function(NEO_MOVE(fn)));
+        }
+    }
+
+    /// Look up a name. Returns nullptr if the name is not defined.
+    const value* find(std::string_view name) const noexcept {
+        auto it = _defs.find(name);
+        return it == _defs.end() ? nullptr : &it->second;
+    }
+};
+
+namespace registry_detail {
+
+inline registry make_default_registry() {
+    registry ret;
+    // Scalar functions
+    ret.define_builtin<"=">();
+    ret.define_builtin<"+">();
+    ret.define_builtin<"×">();
+    ret.define_builtin<"-">();
+    ret.define_builtin<"÷">();
+    ret.define_builtin<"^">();
+    ret.define_builtin<"≠">();
+    ret.define_builtin<">">();
+    ret.define_builtin<"≥">();
+    ret.define_builtin<"<">();
+    ret.define_builtin<"≤">();
+    ret.define_builtin<"⌊">();
+    ret.define_builtin<"⌈">();
+    ret.define_builtin<"|">();
+    ret.define_builtin<"∧">();
+    ret.define_builtin<"∨">();
+    ret.define_builtin<"¬">();
+    // Ranges
+    ret.define_builtin<"⍳">();
+    ret.define_builtin<"⌽">();
+    ret.define_builtin<"↑">();
+    ret.define_builtin<"↓">();
+    // Identities
+    ret.define_builtin<"⊢">();
+    ret.define_builtin<"⊣">();
+    // Modifiers and combinators
+    using namespace comb_detail;
+    ret.define("˙", make_function("˙", modifier<const_fn>{"˙"}));
+    ret.define("⟜", make_function("⟜", combinator<after>{"⟜"}));
+    ret.define("⊸", make_function("⊸", combinator<before>{"⊸"}));
+    ret.define("∘", make_function("∘", combinator<atop>{"∘"}));
+    ret.define("○", make_function("○", combinator<over>{"○"}));
+    ret.define("φ", make_function("φ", modifier<phi_partial>{"φ"}));
+    ret.define("˜", make_function("˜", modifier<self_swap>{"˜"}));
+    ret.define("⊘", make_function("⊘", combinator<valences>{"⊘"}));
+    ret.define("¨", make_function("¨", modifier<over_each>{"¨"}));
+    ret.define("/", make_function("/", modifier<fold>{"/"}));
+    ret.define("\\", make_function("\\", modifier<scan>{"\\"}));
+    // Constants
+    ret.define_builtin<"π">();
+    return ret;
+}
+
+}  // namespace registry_detail
+
+/**
+ * @brief Obtain the registry of the runtime-representable stdlib entities.
+ *
+ * Scalar and range functions adapt the statically-typed define<> entities. Modifiers and
+ * combinators have runtime implementations in rt/comb.hpp. Infinity "∞" and the parallel modifier
+ * "∥" have no runtime representation and are not defined.
+ */
+inline const registry& default_registry() {
+    static const registry reg = registry_detail::make_default_registry();
+    return reg;
+}
+
+}  // namespace lmno::rt
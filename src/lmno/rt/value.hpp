@@ -0,0 +1,183 @@
+#pragma once
+
+#include "../ast.hpp"
+#include "../rational.hpp"
+#include "../render.hpp"
+
+#include <neo/fwd.hpp>
+
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace lmno::rt {
+
+/**
+ * @brief Exception thrown when runtime code cannot be parsed or evaluated
+ */
+class error : public std::runtime_error {
+public:
+    using runtime_error::runtime_error;
+};
+
+class value;
+class function_impl;
+
+/// A runtime array of values. The runtime analog of a strand or a materialized range.
+using array = std::vector<value>;
+
+/**
+ * @brief A reference-counted handle to an immutable runtime function
+ */
+class function {
+    std::shared_ptr<const function_impl> _impl;
+
+public:
+    function() = default;
+    explicit function(std::shared_ptr<const function_impl> impl) noexcept
+        : _impl(NEO_MOVE(impl)) {}
+
+    /// Obtain the implementation of this function
+    const function_impl& impl() const noexcept { return *_impl; }
+
+    value operator()(const value& x) const;
+    value operator()(const value& w, const value& x) const;
+
+    /// Two functions are equal only if they are the same function object
+    bool operator==(const function& other) const noexcept { return _impl == other._impl; }
+};
+
+/**
+ * @brief A dynamically-typed lmno value: Nothing "·", an integer, a float, a rational, an array,
+ * or a function.
+ */
+class value {
+public:
+    using variant_type
+        = std::variant<ast::nothing, std::int64_t, double, rational, array, function>;
+
+private:
+    variant_type _var;
+
+public:
+    value() = default;
+    value(ast::nothing) noexcept {}
+
+    template <std::integral I>
+    value(I i) noexcept
+        : _var(static_cast<std::int64_t>(i)) {}
+
+    template <std::floating_point D>
+    value(D d) noexcept
+        : _var(static_cast<double>(d)) {}
+
+    value(rational q) noexcept
+        : _var(q) {}
+    value(array arr) noexcept
+        : _var(NEO_MOVE(arr)) {}
+    value(function fn) noexcept
+        : _var(NEO_MOVE(fn)) {}
+
+    /// Obtain the underlying variant
+    const variant_type& variant() const noexcept { return _var; }
+
+    /// Determine whether this value holds a T
+    template <typename T>
+    bool holds() const noexcept {
+        return std::holds_alternative<T>(_var);
+    }
+
+    /// Obtain the T held by this value. Throws rt::error if it holds something else.
+    template <typename T>
+    const T& get() const {
+        if (auto p = std::get_if<T>(&_var)) {
+            return *p;
+        }
+        throw error(std::string("Expected a value of type '") + std::string(type_name<T>())
+                    + "', but got a value of type '" + std::string(type_name()) + "'");
+    }
+
+    /// Get the name of the type of the given alternative
+    template <typename T>
+    static constexpr std::string_view type_name() noexcept {
+        if constexpr (std::same_as<T, ast::nothing>) {
+            return "nothing";
+        } else if constexpr (std::same_as<T, std::int64_t>) {
+            return "integer";
+        } else if constexpr (std::same_as<T, double>) {
+            return "float";
+        } else if constexpr (std::same_as<T, rational>) {
+            return "rational";
+        } else if constexpr (std::same_as<T, array>) {
+            return "array";
+        } else {
+            static_assert(std::same_as<T, function>);
+            return "function";
+        }
+    }
+
+    /// Get the name of the type of the held value
+    std::string_view type_name() const noexcept {
+        return std::visit([]<typename T>(const T&) { return type_name<T>(); }, _var);
+    }
+
+    /// Values are equal if they hold the same alternative with equal values
+    friend bool operator==(const value& lhs, const value& rhs) noexcept {
+        if (lhs._var.index() != rhs._var.index()) {
+            return false;
+        }
+        return std::visit(
+            [&]<typename T>(const T& l) {
+                if constexpr (std::same_as<T, ast::nothing>) {
+                    return true;
+                } else {
+                    return l == *std::get_if<T>(&rhs._var);
+                }
+            },
+            lhs._var);
+    }
+};
+
+/**
+ * @brief Base class of all runtime function implementations
+ */
+class function_impl {
+public:
+    virtual ~function_impl() = default;
+
+    /// A short human-readable spelling of the function, used in diagnostics
+    virtual std::string name() const = 0;
+
+    /// Invoke the function monadically
+    virtual value call(const value& x) const = 0;
+    /// Invoke the function dyadically
+    virtual value call(const value& w, const value& x) const = 0;
+
+    /// Obtain the identity element of the function when used to fold integers, if it has one
+    virtual std::optional<value> identity() const { return std::nullopt; }
+};
+
+inline value function::operator()(const value& x) const { return _impl->call(x); }
+inline value function::operator()(const value& w, const value& x) const {
+    return _impl->call(w, x);
+}
+
+}  // namespace lmno::rt
+
+namespace lmno {
+
+template <>
+constexpr inline auto render::type_v<rt::value> = cx_str{"lmno::rt::value"};
+
+template <>
+constexpr inline auto render::type_v<rt::function> = cx_str{"lmno::rt::function"};
+
+}  // namespace lmno
@@ -0,0 +1,390 @@
+#pragma once
+
+#include "./bytecode.hpp"
+#include "./parse.hpp"
+#include "./registry.hpp"
+#include "./value.hpp"
+
+#include <neo/fwd.hpp>
+
+#include <compare>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace lmno::rt {
+
+/**
+ * @brief A stack machine that executes bytecode.
+ *
+ * Each call frame occupies a window of the value stack: The frame's local slots, followed by its
+ * operand stack. The stack is allocated up-front and is only grown if a call nests deeper than
+ * the stack allows, so evaluation does not allocate frames.
+ */
+class vm {
+    std::vector<value> _stack;
+    std::size_t        _top = 0;
+
+    // Pops the frame beginning at `base`, even if execution throws
+    struct frame_guard {
+        vm&         self;
+        std::size_t base;
+        std::size_t n_slots;
+
+        ~frame_guard() {
+            // Release the values held by the frame's locals
+            for (auto i = base; i < base + n_slots; ++i) {
+                self._stack[i] = ast::nothing{};
+            }
+            self._top = base;
+        }
+    };
+
+    static const function& _as_function(const value& fn) {
+        if (not fn.holds<function>()) {
+            throw error("A value of type '" + std::string(fn.type_name()) + "' is not invocable");
+        }
+        return fn.get<function>();
+    }
+
+    value _execute(const bytecode& code, const code_segment& seg, std::size_t base);
+
+    // Apply a scalar primitive directly to the top operand if it is an integer or a float, or else
+    // call the global function that it stands for
+    template <typename Op>
+    void _scalar1(const bytecode& code, std::uint32_t global, std::size_t sp, Op op);
+
+    // Apply a scalar primitive directly to the top two operands if they are both integers or both
+    // floats, or else call the global function that it stands for
+    template <typename Op>
+    void _scalar2(const bytecode& code, std::uint32_t global, std::size_t& sp, Op op);
+
+public:
+    /// The initial number of values in the stack
+    static constexpr std::size_t default_capacity = 1024;
+
+    explicit vm(std::size_t capacity = default_capacity)
+        : _stack(capacity) {}
+
+    vm(const vm&) = delete;
+    vm& operator=(const vm&) = delete;
+
+    /// Obtain the machine of the calling thread
+    static vm& current() noexcept {
+        thread_local vm inst;
+        return inst;
+    }
+
+    /// Execute the top-level code segment of the given program. The program must be owned by a
+    /// std::shared_ptr, which closures that it creates will share.
+    value run(const bytecode& code) {
+        auto& seg  = code.segments.front();
+        auto  base = _top;
+        _reserve(base + seg.n_slots + seg.max_depth);
+        frame_guard guard{*this, base, seg.n_slots};
+        return _execute(code, seg, base);
+    }
+
+    /**
+     * @brief Execute a code segment as a function call
+     *
+     * @param code The program
+     * @param segment The index of the code segment to execute
+     * @param captures The values to place in the segment's capture slots
+     * @param w The left argument α, or nothing "·" for a monadic call
+     * @param x The right argument ω
+     */
+    value call(const bytecode&           code,
+               std::uint32_t             segment,
+               const std::vector<value>& captures,
+               const value&              w,
+               const value&              x) {
+        auto& seg  = code.segments[segment];
+        auto  base = _top;
+        _reserve(base + seg.n_slots + seg.max_depth);
+        frame_guard guard{*this, base, seg.n_slots};
+        _stack[base]     = w;
+        _stack[base + 1] = x;
+        for (std::size_t i = 0; i < captures.size(); ++i) {
+            _stack[base + seg.captures[i].inner] = captures[i];
+        }
+        return _execute(code, seg, base);
+    }
+
+private:
+    void _reserve(std::size_t size) {
+        if (size > _stack.size()) {
+            // References into the stack are not held across calls, so it is safe to move it
+            _stack.resize((std::max)(size, _stack.size() * 2));
+        }
+    }
+};
+
+namespace vm_detail {
+
+// The scalar primitives of the bytecode, which agree with the stdlib on integers and floats
+inline constexpr auto negate        = [](auto x) { return -x; };
+inline constexpr auto add           = [](auto w, auto x) { return w + x; };
+inline constexpr auto subtract      = [](auto w, auto x) { return w - x; };
+inline constexpr auto multiply      = [](auto w, auto x) { return w * x; };
+inline constexpr auto equal         = [](auto w, auto x) { return w == x; };
+inline constexpr auto not_equal     = [](auto w, auto x) { return w != x; };
+inline constexpr auto less          = [](auto w, auto x) { return std::strong_order(w, x) < 0; };
+inline constexpr auto less_equal    = [](auto w, auto x) { return std::strong_order(w, x) <= 0; };
+inline constexpr auto greater       = [](auto w, auto x) { return std::strong_order(w, x) > 0; };
+inline constexpr auto greater_equal = [](auto w, auto x) { return std::strong_order(w, x) >= 0; };
+
+inline constexpr auto min = [](auto w, auto x) { return std::strong_order(w, x) < 0 ? w : x; };
+inline constexpr auto max = [](auto w, auto x) { return std::strong_order(w, x) < 0 ? x : w; };
+
+}  // namespace vm_detail
+
+/**
+ * @brief A closure object generated from a function block in bytecode, holding a copy of the
+ * values that it captures from the enclosing frame.
+ *
+ * A closure that captures nothing is stored in the bytecode itself (see share_bytecode()), and
+ * does not keep it alive: The function handles that refer to it share ownership of the bytecode.
+ */
+class bytecode_closure : public function_impl {
+    const bytecode*                 _code;
+    std::shared_ptr<const bytecode> _keep_alive;
+    std::uint32_t                   _segment;
+    std::vector<value>              _captures;
+
+public:
+    bytecode_closure(const bytecode&                 code,
+                     std::shared_ptr<const bytecode> keep_alive,
+                     std::uint32_t                   segment,
+                     std::vector<value>              captures)
+        : _code(&code)
+        , _keep_alive(NEO_MOVE(keep_alive))
+        , _segment(segment)
+        , _captures(NEO_MOVE(captures)) {}
+
+    std::string name() const override { return "(closure)"; }
+
+    value call(const value& x) const override {
+        return vm::current().call(*_code, _segment, _captures, ast::nothing{}, x);
+    }
+
+    value call(const value& w, const value& x) const override {
+        return vm::current().call(*_code, _segment, _captures, w, x);
+    }
+};
+
+template <typename Op>
+void vm::_scalar1(const bytecode& code, std::uint32_t global, std::size_t sp, Op op) {
+    auto& x = _stack[sp - 1];
+    if (auto i = std::get_if<std::int64_t>(&x.variant())) {
+        x = op(*i);
+    } else if (auto d = std::get_if<double>(&x.variant())) {
+        x = op(*d);
+    } else {
+        auto arg = NEO_MOVE(x);
+        _stack[sp - 1] = _as_function(code.globals[global])(arg);
+    }
+}
+
+template <typename Op>
+void vm::_scalar2(const bytecode& code, std::uint32_t global, std::size_t& sp, Op op) {
+    auto& w  = _stack[sp - 2];
+    auto& x  = _stack[sp - 1];
+    auto  wi = std::get_if<std::int64_t>(&w.variant());
+    auto  xi = std::get_if<std::int64_t>(&x.variant());
+    auto  wd = std::get_if<double>(&w.variant());
+    auto  xd = std::get_if<double>(&x.variant());
+    if (wi and xi) {
+        w = op(*wi, *xi);
+    } else if (wd and xd) {
+        w = op(*wd, *xd);
+    } else {
+        auto x_arg = NEO_MOVE(x);
+        auto w_arg = NEO_MOVE(w);
+        _stack[sp - 2] = _as_function(code.globals[global])(w_arg, x_arg);
+    }
+    --sp;
+}
+
+inline value vm::_execute(const bytecode& code, const code_segment& seg, std::size_t base) {
+    // The operand stack pointer
+    auto sp = base + seg.n_slots;
+    _top    = sp + seg.max_depth;
+    for (auto& inst : seg.code) {
+        switch (inst.op) {
+        case opcode::push_const:
+            _stack[sp++] = code.constants[inst.arg];
+            break;
+        case opcode::push_nothing:
+            _stack[sp++] = ast::nothing{};
+            break;
+        case opcode::load_local:
+            _stack[sp++] = _stack[base + inst.arg];
+            break;
+        case opcode::load_global:
+            _stack[sp++] = code.globals[inst.arg];
+            break;
+        case opcode::load_undefined:
+            throw error("The name '" + code.names[inst.arg] + "' is not defined");
+        case opcode::store_local:
+            _stack[base + inst.arg] = NEO_MOVE(_stack[--sp]);
+            break;
+        case opcode::pop:
+            _stack[--sp] = ast::nothing{};
+            break;
+        case opcode::call1: {
+            // Move the operands out of the stack: The call may grow (and move) the stack
+            auto x  = NEO_MOVE(_stack[--sp]);
+            auto fn = NEO_MOVE(_stack[--sp]);
+            _stack[sp++] = _as_function(fn)(x);
+            break;
+        }
+        case opcode::call2: {
+            auto x  = NEO_MOVE(_stack[--sp]);
+            auto fn = NEO_MOVE(_stack[--sp]);
+            auto w  = NEO_MOVE(_stack[--sp]);
+            _stack[sp++] = _as_function(fn)(w, x);
+            break;
+        }
+        case opcode::call1_global: {
+            auto x         = NEO_MOVE(_stack[sp - 1]);
+            _stack[sp - 1] = _as_function(code.globals[inst.arg])(x);
+            break;
+        }
+        case opcode::call2_global: {
+            auto x = NEO_MOVE(_stack[--sp]);
+            auto w = NEO_MOVE(_stack[sp - 1]);
+            _stack[sp - 1] = _as_function(code.globals[inst.arg])(w, x);
+            break;
+        }
+        case opcode::negate:
+            _scalar1(code, inst.arg, sp, vm_detail::negate);
+            break;
+        case opcode::add:
+            _scalar2(code, inst.arg, sp, vm_detail::add);
+            break;
+        case opcode::subtract:
+            _scalar2(code, inst.arg, sp, vm_detail::subtract);
+            break;
+        case opcode::multiply:
+            _scalar2(code, inst.arg, sp, vm_detail::multiply);
+            break;
+        case opcode::equal:
+            _scalar2(code, inst.arg, sp, vm_detail::equal);
+            break;
+        case opcode::not_equal:
+            _scalar2(code, inst.arg, sp, vm_detail::not_equal);
+            break;
+        case opcode::less:
+            _scalar2(code, inst.arg, sp, vm_detail::less);
+            break;
+        case opcode::less_equal:
+            _scalar2(code, inst.arg, sp, vm_detail::less_equal);
+            break;
+        case opcode::greater:
+            _scalar2(code, inst.arg, sp, vm_detail::greater);
+            break;
+        case opcode::greater_equal:
+            _scalar2(code, inst.arg, sp, vm_detail::greater_equal);
+            break;
+        case opcode::min:
+            _scalar2(code, inst.arg, sp, vm_detail::min);
+            break;
+        case opcode::max:
+            _scalar2(code, inst.arg, sp, vm_detail::max);
+            break;
+        case opcode::make_array: {
+            array arr;
+            arr.reserve(inst.arg);
+            sp -= inst.arg;
+            for (std::uint32_t i = 0; i < inst.arg; ++i) {
+                arr.push_back(NEO_MOVE(_stack[sp + i]));
+            }
+            _stack[sp++] = NEO_MOVE(arr);
+            break;
+        }
+        case opcode::make_closure: {
+            auto owner = code.shared_from_this();
+            if (inst.arg < code.shared_closures.size() and code.shared_closures[inst.arg]) {
+                // Refer to the closure that the bytecode holds, sharing ownership of the bytecode
+                auto closure = code.shared_closures[inst.arg].get();
+                _stack[sp++] = function(std::shared_ptr<const function_impl>(NEO_MOVE(owner),
+                                                                             closure));
+                break;
+            }
+            auto& inner = code.segments[inst.arg];
+            std::vector<value> captures;
+            captures.reserve(inner.captures.size());
+            for (auto& cap : inner.captures) {
+                captures.push_back(_stack[base + cap.outer]);
+            }
+            _stack[sp++] = function(std::make_shared<const bytecode_closure>(code,
+                                                                             NEO_MOVE(owner),
+                                                                             inst.arg,
+                                                                             NEO_MOVE(captures)));
+            break;
+        }
+        case opcode::ret:
+            return NEO_MOVE(_stack[--sp]);
+        }
+    }
+    throw error("Bytecode segment has no return");
+}
+
+/**
+ * @brief A runtime-compiled lmno program, compiled to bytecode.
+ *
+ * This evaluates the same as rt::program, but executes on a stack machine rather than walking the
+ * syntax tree. Programs are immutable and cheap to copy. Functions created by a program keep it
+ * alive.
+ */
+class bytecode_program {
+    std::shared_ptr<const bytecode> _code;
+
+public:
+    explicit bytecode_program(std::shared_ptr<const bytecode> code) noexcept
+        : _code(NEO_MOVE(code)) {}
+
+    /// Evaluate the program on the calling thread's machine
+    value operator()() const { return vm::current().run(*_code); }
+    /// Evaluate the program on the given machine
+    value operator()(vm& machine) const { return machine.run(*_code); }
+
+    /// Obtain the compiled bytecode
+    const bytecode& code() const noexcept { return *_code; }
+};
+
+/**
+ * @brief Place compiled bytecode in shared storage, and create the closures of the blocks that
+ * capture nothing. Evaluating such a block then refers to the closure instead of allocating one.
+ */
+inline std::shared_ptr<const bytecode> share_bytecode(bytecode code) {
+    auto shared = std::make_shared<bytecode>(NEO_MOVE(code));
+    shared->shared_closures.resize(shared->segments.size());
+    // Segment 0 is the top level of the program, which is not a block
+    for (std::uint32_t i = 1; i < shared->segments.size(); ++i) {
+        if (shared->segments[i].captures.empty()) {
+            shared->shared_closures[i]
+                = std::make_unique<const bytecode_closure>(*shared, nullptr, i, array{});
+        }
+    }
+    return shared;
+}
+
+/**
+ * @brief Compile lmno code at runtime to bytecode.
+ *
+ * @param code The code to compile
+ * @param reg The registry of names that are visible to the code
+ * @throws rt::error if the code is malformed
+ */
+inline bytecode_program compile_bytecode(std::string_view  code,
+                                         const registry& reg = default_registry()) {
+    auto tree = rt::parse(code);
+    return bytecode_program{share_bytecode(rt::compile_bytecode(tree, reg))};
+}
+
+}  // namespace lmno::rt
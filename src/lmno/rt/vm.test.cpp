@@ -0,0 +1,148 @@
+#include "./vm.hpp"
+
+#include "./interp.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace rt = lmno::rt;
+using lmno::rational;
+
+namespace {
+
+rt::value run(std::string_view code) { return rt::compile_bytecode(code)(); }
+
+}  // namespace
+
+TEST_CASE("Compile to bytecode") {
+    auto prog = rt::compile_bytecode("x ← 4; {ω + x} 3");
+    auto& bc  = prog.code();
+    // The top level, and the block
+    REQUIRE(bc.segments.size() == 2);
+    CHECK(bc.segments[0].code.back().op == rt::opcode::ret);
+    // The block has slots for α, ω, and the captured "x"
+    CHECK(bc.segments[1].n_slots == 3);
+    CHECK(bc.segments[1].captures.size() == 1);
+    // "+" is resolved from the registry ahead of time
+    CHECK(bc.globals.size() == 1);
+
+    // Names that are not in scope are only an error if they are evaluated
+    CHECK_NOTHROW(rt::compile_bytecode("{foo} 2"));
+    CHECK_THROWS_AS(rt::compile_bytecode("(1 + 2"), rt::error);
+}
+
+TEST_CASE("Compile scalar primitives to opcodes") {
+    auto ops = [](std::string_view code) {
+        auto                    prog = rt::compile_bytecode(code);
+        std::vector<rt::opcode> ret;
+        for (auto inst : prog.code().segments[0].code) {
+            ret.push_back(inst.op);
+        }
+        return ret;
+    };
+    auto has = [&](std::string_view code, rt::opcode op) {
+        return std::ranges::count(ops(code), op) == 1;
+    };
+    CHECK(has("3 + 4", rt::opcode::add));
+    CHECK(has("- 4", rt::opcode::negate));
+    CHECK(has("3 - 4", rt::opcode::subtract));
+    CHECK(has("3 ⌈ 4", rt::opcode::max));
+    // Other global functions are called without pushing them
+    CHECK(has("⍳ 4", rt::opcode::call1_global));
+    CHECK(has("2 ↓ 1‿2‿3", rt::opcode::call2_global));
+    // A name that is bound in the program is not the primitive
+    CHECK(has("+ ← -; 3 + 4", rt::opcode::call2));
+    CHECK(has("f ← ⍳; f 4", rt::opcode::call1));
+    // Nor is a name that the registry binds to something else
+    rt::registry reg = rt::default_registry();
+    reg.define("+", *reg.find("-"));
+    auto prog = rt::compile_bytecode("3 + 4", reg);
+    CHECK(std::ranges::count(prog.code().segments[0].code, rt::opcode::add, &rt::instruction::op)
+          == 0);
+    CHECK(prog() == -1);
+}
+
+TEST_CASE("Bytecode agrees with the tree-walking interpreter") {
+    auto code = GENERATE(as<std::string_view>{},
+                         "3+4",
+                         "- 4+3",
+                         "4÷3",
+                         "·",
+                         "1‿2‿3",
+                         "2↓·⍳5",
+                         "\\:+ 1‿2‿3",
+                         "¨:{ω×ω} 1‿2‿3",
+                         "(/:+∘⍳) 6",
+                         "8 (-φ:⌈˜:-) 12",
+                         "{0⊸·/{α+ω}$⍳ω} 4",
+                         "{{ω}2}0",
+                         "x ← 4; x × x",
+                         "f ← {ω + 1}; f 41",
+                         "2 {α × ω} 21",
+                         "x ← 1; f ← {x + ω}; x ← 10; f 1",
+                         "x ← 3; ({y ← ω; {x + y + ω}} 4) 5",
+                         "f ← {ω}; 1; f 2",
+                         "+ ← -; 3 + 2",
+                         "π + π",
+                         "- π",
+                         "π × 2",
+                         "(π - π) = 0",
+                         "2 ≤ 2",
+                         "2 ≥ 3",
+                         "1 ≠ 2",
+                         "1 > 0",
+                         "(1÷2) + 1÷2",
+                         "- 1÷2");
+    INFO(code);
+    CHECK(run(code) == rt::eval(code));
+}
+
+TEST_CASE("Run bytecode") {
+    rt::registry reg = rt::default_registry();
+    reg.define("limit", 10);
+    CHECK(rt::compile_bytecode("limit ⌊ 42", reg)() == 10);
+    // Floats are only given by the host
+    reg.define("half", 0.5);
+    CHECK(rt::compile_bytecode("half + half", reg)() == 1.0);
+    CHECK(rt::compile_bytecode("- half", reg)() == -0.5);
+    CHECK(rt::compile_bytecode("half ⌈ half × 3", reg)() == 1.5);
+    CHECK(rt::compile_bytecode("half < half", reg)() == 0);
+    CHECK(rt::compile_bytecode("half < 1", reg)() == 1);
+
+    // Functions may be called from C++
+    auto square = run("{ω × ω}").get<rt::function>();
+    CHECK(square(7) == 49);
+    CHECK(square(rational{1, 2}) == rational{1, 4});
+
+    // Programs may be evaluated many times, and on a given machine
+    auto prog = rt::compile_bytecode("/:+ $ ⍳ 100");
+    CHECK(prog() == 4950);
+    CHECK(prog() == 4950);
+    rt::vm machine{8};
+    CHECK(prog(machine) == 4950);
+
+    // A block that captures nothing is the same function each time it is evaluated
+    auto id = rt::compile_bytecode("{ω}");
+    CHECK(id() == id());
+    auto with_capture = rt::compile_bytecode("x ← 1; {x}");
+    CHECK(with_capture() != with_capture());
+
+    // Nested calls grow the stack
+    auto sum = run("{/:{α + ({ω} ω)} $ ⍳ω}").get<rt::function>();
+    CHECK(sum(500) == 124750);
+    CHECK(rt::compile_bytecode("{{{{{ω}ω}ω}ω}ω} 7")(machine) == 7);
+}
+
+TEST_CASE("Bytecode runtime errors") {
+    CHECK_THROWS_AS(run("foo"), rt::error);
+    CHECK_THROWS_AS(run("{foo} 2"), rt::error);
+    CHECK_THROWS_AS(run("1 2"), rt::error);
+    CHECK_THROWS_AS(run("1 + 1‿2"), rt::error);
+    CHECK_THROWS_AS(run("3 ÷ 0"), rt::error);
+    // The machine is left in a usable state after an error
+    CHECK_THROWS_AS(run("{ω + 1‿2} 1"), rt::error);
+    CHECK(run("{ω + 1} 1") == 2);
+}
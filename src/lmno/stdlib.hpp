@@ -6,4 +6,5 @@
 #include "./stdlib/constants.hpp"
 #include "./stdlib/logic.hpp"
 #include "./stdlib/numeric.hpp"
+#include "./stdlib/parallel.hpp"
 #include "./stdlib/valences.hpp"
@@ -47,6 +47,30 @@ struct over_each_view {
 };
 LMNO_AUTO_CTAD_GUIDE(over_each_view);
 
+template <typename T>
+constexpr bool is_over_each_view_v = false;
+
+template <typename F, typename V>
+constexpr bool is_over_each_view_v<over_each_view<F, V>> = true;
+
+namespace msg {
+
+struct not_input_range {
+    static constexpr cx_str text = "Argument of type {:'} is not an input-range";
+};
+
+struct not_viewable_range {
+    static constexpr cx_str text = "Argument of type {:'} is a range, but is not a viewable range.";
+};
+
+struct over_each_not_invocable {
+    static constexpr cx_str text
+        = "Over-each function {:'} is not unary-invocable with the range's "
+          "reference-type {:'} (from range of type {:'})";
+};
+
+}  // namespace msg
+
 template <typename F>
 struct over_each {
     NEO_NO_UNIQUE_ADDRESS F _fn;
@@ -66,23 +90,19 @@ struct over_each {
     template <typename X>
     static auto error() {
         using Xu = unconst_t<X>;
-        using err::fmt_error_t;
-        using render::type_v;
+        using err::type_arg_v;
         if constexpr (not input_range_convertible<Xu>) {
-            return fmt_error_t<"Argument of type {:'} is not an input-range", type_v<X>>{};
+            return err::msg_error_t<msg::not_input_range, type_arg_v<X>>{};
         } else if constexpr (not viewable_range_convertible<Xu>) {
-            return fmt_error_t<"Argument of type {:'} is a range, but is not a viewable range.",
-                               type_v<X>>{};
+            return err::msg_error_t<msg::not_viewable_range, type_arg_v<X>>{};
         } else {
             using ref = range_reference_t<Xu>;
             if constexpr (not invocable<F, ref>) {
-                return err::fmt_errorex_t<
-                    invoke_error_t<F, ref>,
-                    "Over-each function {:'} is not unary-invocable with the range's "
-                    "reference-type {:'} (from range of type {:'})",
-                    type_v<F>,
-                    type_v<ref>,
-                    type_v<X>>{};
+                return err::msg_errorex_t<invoke_error_t<F, ref>,
+                                          msg::over_each_not_invocable,
+                                          type_arg_v<F>,
+                                          type_arg_v<ref>,
+                                          type_arg_v<X>>{};
             }
         }
     }
@@ -112,6 +132,18 @@ struct reverse_view {
 };
 LMNO_AUTO_CTAD_GUIDE(reverse_view);
 
+namespace msg {
+
+struct type_not_viewable_range {
+    static constexpr cx_str text = "Type {:'} is not a viewable-range";
+};
+
+struct type_not_bidirectional_range {
+    static constexpr cx_str text = "Type {:'} is not a bidirectional range";
+};
+
+}  // namespace msg
+
 struct reverse {
     LMNO_INDIRECT_INVOCABLE(reverse);
 
@@ -123,9 +155,9 @@ struct reverse {
     template <typename R_, typename R = unconst_t<R_>>
     static auto error() {
         if constexpr (not viewable_range_convertible<R>) {
-            return err::fmt_error_t<"Type {:'} is not a viewable-range">{};
+            return err::msg_error_t<msg::type_not_viewable_range, err::type_arg_v<R_>>{};
         } else if constexpr (not bidirectional_range_convertible<R>) {
-            return err::fmt_error_t<"Type {:'} is not a bidirectional range">{};
+            return err::msg_error_t<msg::type_not_bidirectional_range, err::type_arg_v<R_>>{};
         }
     }
 };
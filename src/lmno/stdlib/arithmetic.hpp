@@ -46,50 +46,71 @@ concept dividable_by =  //
         { (num / den) / den } -> multipliable<Denom>;
     };
 
+namespace msg {
+
+struct plus_not_unary {
+    static constexpr cx_str text = "The {:'} operator is not unary-invocable";
+};
+
+struct not_addable {
+    static constexpr cx_str text
+        = "α of type {:'} and ω of type {:'} are not compatible by "
+          "arithmetic addition in (α + ω)";
+};
+
+}  // namespace msg
+
 struct plus {
     template <typename W>
     constexpr auto operator()(W&& w, addable<W> auto&& x) const NEO_RETURNS(w + x);
 
     template <typename X>
     static auto error() {
-        return err::fmt_error_t<"The {:'} operator is not unary-invocable", cx_str{"+"}>{};
+        return err::msg_error_t<msg::plus_not_unary, cx_str{"+"}>{};
     }
 
     template <typename W, typename X>
     static auto error() {
         if constexpr (not addable<unconst_t<W>, unconst_t<X>>) {
-            return err::fmt_error_t<
-                "α of type {:'} and ω of type {:'} are not compatible by "
-                "arithmetic addition in (α + ω)",
-                render::type_v<W>,
-                render::type_v<X>>{};
+            return err::msg_error_t<msg::not_addable, err::type_arg_v<W>, err::type_arg_v<X>>{};
         }
     }
 };
 
 inline auto _recip  = [] NEO_CTL(rational{_1}.recip());
 inline auto _divide = [] NEO_CTL(rational{_1} / _2);
+
+namespace msg {
+
+struct not_rational {
+    static constexpr cx_str text
+        = "Value of type {:'} cannot be converted to a rational number (i.e. lmno::rational)";
+};
+
+struct not_rational_divisor {
+    static constexpr cx_str text
+        = "Value of type {:'} is not valid as the divisor of a rational number";
+};
+
+}  // namespace msg
+
 struct divide_or_reciprocal : polyfun<func_wrap<_recip>, func_wrap<_divide>> {
     template <typename X>
     static auto error() {
-        using render::type_v;
+        using err::type_arg_v;
         if constexpr (not neo::constructible_from<rational, unconst_t<X>>) {
-            return err::fmt_error_t<
-                "Value of type {:'} cannot be converted to a rational number (i.e. lmno::rational)",
-                type_v<X>>{};
+            return err::msg_error_t<msg::not_rational, type_arg_v<X>>{};
         }
     }
 
     template <typename W, typename X>
     static auto error() {
-        using render::type_v;
+        using err::type_arg_v;
         using B = decltype(error<X>());
         if constexpr (not neo::same_as<B, void>) {
             return B{};
         } else if constexpr (not dividable_by<rational, unconst_t<X>>) {
-            return err::fmt_error_t<
-                "Value of type {:'} is not valid as the divisor of a rational number",
-                type_v<X>>{};
+            return err::msg_error_t<msg::not_rational_divisor, type_arg_v<X>>{};
         }
     }
 };
@@ -98,6 +119,7 @@ constexpr inline auto _power = []<typename Base, typename Power>(const Base& b,
     requires requires {
                  { b* b } -> neo::weak_same_as<Base>;
                  { p = p - p };
+                 { p > Power(0) };
              }
 {
     Base acc = Base(1);
@@ -120,14 +142,22 @@ inline auto negative = [] NEO_CTL(-_1);
 inline auto minus    = [] NEO_CTL(_1 - _2);
 struct minus_or_negative : polyfun<func_wrap<negative>, func_wrap<minus>> {};
 
+namespace msg {
+
+struct not_equality_comparable {
+    static constexpr cx_str text
+        = "Values of type {:'} are not equality-comparable with values of type {:'}";
+};
+
+}  // namespace msg
+
 struct requires_equality_comparable {
     template <typename W, typename X, typename Wu = unconst_t<W>, typename Xu = unconst_t<X>>
     static auto error() {
         if constexpr (not neo::equality_comparable_with<W, X>) {
-            return err::fmt_error_t<
-                "Values of type {:'} are not equality-comparable with values of type {:'}",
-                render::type_v<W>,
-                render::type_v<X>>{};
+            return err::msg_error_t<msg::not_equality_comparable,
+                                    err::type_arg_v<W>,
+                                    err::type_arg_v<X>>{};
         }
     }
 };
@@ -139,14 +169,22 @@ struct equal : func_wrap<_eq>, requires_equality_comparable {};
 inline auto _neq = [] NEO_CTL(not _eq(_1, _2));
 struct not_equal : func_wrap<_neq>, requires_equality_comparable {};
 
+namespace msg {
+
+struct not_totally_ordered {
+    static constexpr cx_str text
+        = "Values of type {:'} are not totally-ordered with values of type {:'}";
+};
+
+}  // namespace msg
+
 struct requires_total_ordering {
     template <typename W, typename X, typename Wu = unconst_t<W>, typename Xu = unconst_t<X>>
     static auto error() {
         if constexpr (not neo::totally_ordered_with<W, X>) {
-            return err::fmt_error_t<
-                "Values of type {:'} are not totally-ordered with values of type {:'}",
-                render::type_v<W>,
-                render::type_v<X>>{};
+            return err::msg_error_t<msg::not_totally_ordered,
+                                    err::type_arg_v<W>,
+                                    err::type_arg_v<X>>{};
         }
     }
 };
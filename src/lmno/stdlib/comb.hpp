@@ -129,6 +129,24 @@ constexpr decltype(auto) autoconst_fn(T&& arg) noexcept {
 d88P     888 888     "Y888 "Y8888  888
 */
 
+namespace msg {
+
+struct before_not_invocable {
+    static constexpr cx_str text
+        = "Before-function {:'} is not invocable with an argument of type {:'}";
+};
+
+struct after_not_invocable {
+    static constexpr cx_str text
+        = "Invoking left-hand before-function {:'} with value of\n"
+          "type {:'} results in a value of type {:'}.\n"
+          "\n"
+          "The after-function of type {:'} is not invocable with \n"
+          "arguments α of type {:'} and ω of type {:'}.";
+};
+
+}  // namespace msg
+
 // The "⟜" closure
 template <typename After, typename Before>
 struct after {
@@ -147,29 +165,23 @@ struct after {
 
     template <typename X>
     static auto error() {
-        using render::type_v;
+        using err::type_arg_v;
         if constexpr (not invocable<Before, X>) {
-            return err::fmt_errorex_t<
-                maybe_invoke_error_t<Before, X>,
-                "Before-function {:'} is not invocable with an argument of type {:'}",
-                type_v<Before>,
-                type_v<X>>{};
+            return err::msg_errorex_t<maybe_invoke_error_t<Before, X>,
+                                      msg::before_not_invocable,
+                                      type_arg_v<Before>,
+                                      type_arg_v<X>>{};
         } else {
             using bef_t = invoke_t<Before, X>;
             if constexpr (not invocable<After, bef_t, X>) {
-                return err::fmt_errorex_t<  //
-                    maybe_invoke_error_t<After, bef_t, X>,
-                    "Invoking left-hand before-function {:'} with value of\n"
-                    "type {:'} results in a value of type {:'}.\n"
-                    "\n"
-                    "The after-function of type {:'} is not invocable with \n"
-                    "arguments α of type {:'} and ω of type {:'}.",
-                    type_v<Before>,
-                    type_v<X>,
-                    type_v<bef_t>,
-                    type_v<After>,
-                    type_v<bef_t>,
-                    type_v<X>>{};
+                return err::msg_errorex_t<maybe_invoke_error_t<After, bef_t, X>,
+                                          msg::after_not_invocable,
+                                          type_arg_v<Before>,
+                                          type_arg_v<X>,
+                                          type_arg_v<bef_t>,
+                                          type_arg_v<After>,
+                                          type_arg_v<bef_t>,
+                                          type_arg_v<X>>{};
             }
         }
     }
@@ -205,29 +217,23 @@ struct before {
 
     template <typename X>
     static auto error() {
-        using render::type_v;
+        using err::type_arg_v;
         if constexpr (not invocable<Before, X>) {
-            return err::fmt_errorex_t<
-                maybe_invoke_error_t<Before, X>,
-                "Before-function {:'} is not invocable with an argument of type {:'}",
-                type_v<Before>,
-                type_v<X>>{};
+            return err::msg_errorex_t<maybe_invoke_error_t<Before, X>,
+                                      msg::before_not_invocable,
+                                      type_arg_v<Before>,
+                                      type_arg_v<X>>{};
         } else {
             using bef_t = invoke_t<Before, X>;
             if constexpr (not invocable<After, bef_t, X>) {
-                return err::fmt_errorex_t<  //
-                    maybe_invoke_error_t<After, bef_t, X>,
-                    "Invoking left-hand before-function {:'} with value of\n"
-                    "type {:'} results in a value of type {:'}.\n"
-                    "\n"
-                    "The after-function of type {:'} is not invocable with \n"
-                    "arguments α of type {:'} and ω of type {:'}.",
-                    type_v<Before>,
-                    type_v<X>,
-                    type_v<bef_t>,
-                    type_v<After>,
-                    type_v<bef_t>,
-                    type_v<X>>{};
+                return err::msg_errorex_t<maybe_invoke_error_t<After, bef_t, X>,
+                                          msg::after_not_invocable,
+                                          type_arg_v<Before>,
+                                          type_arg_v<X>,
+                                          type_arg_v<bef_t>,
+                                          type_arg_v<After>,
+                                          type_arg_v<bef_t>,
+                                          type_arg_v<X>>{};
             }
         }
     }
@@ -248,6 +254,37 @@ d88P     888  "Y888 "Y88P"  88888P"
                             888
 */
 
+namespace msg {
+
+struct atop_right_not_unary {
+    static constexpr cx_str text
+        = "Right-hand function of type {:'} is not unary-invocable with ω of type {:'}";
+};
+
+struct atop_left_not_unary {
+    static constexpr cx_str text
+        = "Unary-invoking function {:'} with ω of type {:'} produces an intermediate\n"
+          "of type {:'}.\n\n"
+          "The left-hand function of type {:'} is not unary-invocable with ω of the\n"
+          "intermediate type {:'}";
+};
+
+struct atop_right_not_binary {
+    static constexpr cx_str text
+        = "Right-hand function of type {:'} is not binary-invocable with\n"
+          "arguments of type {:'} and {:'}.";
+};
+
+struct atop_left_not_unary_after_infix {
+    static constexpr cx_str text
+        = "Infix-invoking function {:'} with α of type {:'} and ω of \n"
+          "type {:'} produces an intermediate of type {:'}.\n\n"
+          "The left-hand function of type {:'} is not unary-invocable with ω of the\n"
+          "intermediate type {:'}";
+};
+
+}  // namespace msg
+
 // The "∘" closure
 template <typename F, typename G>
 struct atop {
@@ -266,57 +303,46 @@ struct atop {
 
     template <typename X>
     static auto error() {
-        using render::type_v;
+        using err::type_arg_v;
         using g_type = invoke_t<G, X>;
         if constexpr (any_error<g_type>) {
-            return err::fmt_errorex_t<
-                maybe_invoke_error_t<G, X>,
-                "Right-hand function of type {:'} is not unary-invocable with ω of type {:'}",
-                type_v<G>,
-                type_v<X>>{};
+            return err::msg_errorex_t<maybe_invoke_error_t<G, X>,
+                                      msg::atop_right_not_unary,
+                                      type_arg_v<G>,
+                                      type_arg_v<X>>{};
         } else {
             if constexpr (not invocable<F, g_type>) {
-                return err::fmt_errorex_t<  //
-                    maybe_invoke_error_t<F, g_type>,
-                    "Unary-invoking function {:'} with ω of type {:'} produces an intermediate\n"
-                    "of type {:'}.\n\n"
-                    "The left-hand function of type {:'} is not unary-invocable with ω of the\n"
-                    "intermediate type {:'}",
-                    type_v<G>,
-                    type_v<X>,
-                    type_v<g_type>,
-                    type_v<F>,
-                    type_v<g_type>>{};
+                return err::msg_errorex_t<maybe_invoke_error_t<F, g_type>,
+                                          msg::atop_left_not_unary,
+                                          type_arg_v<G>,
+                                          type_arg_v<X>,
+                                          type_arg_v<g_type>,
+                                          type_arg_v<F>,
+                                          type_arg_v<g_type>>{};
             }
         }
     }
 
     template <typename W, typename X>
     static auto error() {
-        using render::type_v;
+        using err::type_arg_v;
         if constexpr (not invocable<G, W, X>) {
-            return err::fmt_errorex_t<  //
-                maybe_invoke_error_t<G, W, X>,
-                "Right-hand function of type {:'} is not binary-invocable with\n"
-                "arguments of type {:'} and {:'}.",
-                type_v<G>,
-                type_v<W>,
-                type_v<X>>{};
+            return err::msg_errorex_t<maybe_invoke_error_t<G, W, X>,
+                                      msg::atop_right_not_binary,
+                                      type_arg_v<G>,
+                                      type_arg_v<W>,
+                                      type_arg_v<X>>{};
         } else {
             using g_result = invoke_t<G, W, X>;
             if constexpr (not invocable<F, g_result>) {
-                return err::fmt_errorex_t<  //
-                    maybe_invoke_error_t<F, g_result>,
-                    "Infix-invoking function {:'} with α of type {:'} and ω of \n"
-                    "type {:'} produces an intermediate of type {:'}.\n\n"
-                    "The left-hand function of type {:'} is not unary-invocable with ω of the\n"
-                    "intermediate type {:'}",
-                    type_v<G>,
-                    type_v<W>,
-                    type_v<X>,
-                    type_v<g_result>,
-                    type_v<F>,
-                    type_v<g_result>>{};
+                return err::msg_errorex_t<maybe_invoke_error_t<F, g_result>,
+                                          msg::atop_left_not_unary_after_infix,
+                                          type_arg_v<G>,
+                                          type_arg_v<W>,
+                                          type_arg_v<X>,
+                                          type_arg_v<g_result>,
+                                          type_arg_v<F>,
+                                          type_arg_v<g_result>>{};
             }
         }
     }
@@ -369,6 +395,32 @@ LMNO_AUTO_CTAD_GUIDE(over);
 888        888  888 888
 */
 
+namespace msg {
+
+struct phi_left_tine_failed {
+    static constexpr cx_str text
+        = "Error while unary-invoking left-tine function {:'} with ω of type {:'}";
+};
+
+struct phi_right_tine_failed {
+    static constexpr cx_str text
+        = "Error while unary-invoking right-tine function {:'} with ω of type {:'}";
+};
+
+struct phi_center_tine_failed {
+    static constexpr cx_str text
+        = "φ: Unary-invoking left-tine {:'} with ω {:'} produced an\n"
+          "   intermediate α' of type {:'},\n"
+          "\n"
+          "   Unary-invoking right-tine {:'} with ω {:'} produced an\n"
+          "   intermediate ω' of type {:'}.\n"
+          "\n"
+          "   Binary-invoking center-tine {:'} with\n"
+          "   α' of type {:'} and ω' of type {:'} fails.";
+};
+
+}  // namespace msg
+
 // The "φ" closure, equivalent to an APL fork
 template <typename F, typename H, typename G>
 struct phi {
@@ -388,42 +440,32 @@ struct phi {
 
     template <typename X>
     static auto error() {
-        using render::type_v;
+        using err::type_arg_v;
         if constexpr (not invocable<F, X>) {
-            return err::fmt_errorex_t<
-                maybe_invoke_error_t<F, X>,
-                "Error while unary-invoking left-tine function {:'} with ω of type {:'}",
-                type_v<F>,
-                type_v<X>>{};
+            return err::msg_errorex_t<maybe_invoke_error_t<F, X>,
+                                      msg::phi_left_tine_failed,
+                                      type_arg_v<F>,
+                                      type_arg_v<X>>{};
         } else if constexpr (not invocable<G, X>) {
-            return err::fmt_errorex_t<
-                maybe_invoke_error_t<G, X>,
-                "Error while unary-invoking right-tine function {:'} with ω of type {:'}",
-                type_v<G>,
-                type_v<X>>{};
+            return err::msg_errorex_t<maybe_invoke_error_t<G, X>,
+                                      msg::phi_right_tine_failed,
+                                      type_arg_v<G>,
+                                      type_arg_v<X>>{};
         } else {
             using f_result = invoke_t<F, X>;
             using g_result = invoke_t<G, X>;
             if constexpr (not invocable<H, f_result, g_result>) {
-                return err::fmt_errorex_t<  //
-                    maybe_invoke_error_t<H, f_result, g_result>,
-                    "φ: Unary-invoking left-tine {:'} with ω {:'} produced an\n"
-                    "   intermediate α' of type {:'},\n"
-                    "\n"
-                    "   Unary-invoking right-tine {:'} with ω {:'} produced an\n"
-                    "   intermediate ω' of type {:'}.\n"
-                    "\n"
-                    "   Binary-invoking center-tine {:'} with\n"
-                    "   α' of type {:'} and ω' of type {:'} fails.",
-                    type_v<F>,
-                    type_v<X>,
-                    type_v<f_result>,
-                    type_v<G>,
-                    type_v<X>,
-                    type_v<g_result>,
-                    type_v<H>,
-                    type_v<f_result>,
-                    type_v<g_result>>{};
+                return err::msg_errorex_t<maybe_invoke_error_t<H, f_result, g_result>,
+                                          msg::phi_center_tine_failed,
+                                          type_arg_v<F>,
+                                          type_arg_v<X>,
+                                          type_arg_v<f_result>,
+                                          type_arg_v<G>,
+                                          type_arg_v<X>,
+                                          type_arg_v<g_result>,
+                                          type_arg_v<H>,
+                                          type_arg_v<f_result>,
+                                          type_arg_v<g_result>>{};
             }
         }
     }
@@ -455,6 +497,19 @@ Y88b  d88P Y8b.     888 888   d88P       Y88b  d88P Y88b 888 d88P 888  888 888 d
                                                                            888
                                                                            888
 */
+
+namespace msg {
+
+struct self_swap_not_binary {
+    static constexpr cx_str text
+        = "Self-operator ˜ will binary-invoke function {:'} with left-hand\n"
+          "and right-hand both of type {:'}.\n\n"
+          "Function {:'} is not binary-invocable with α and ω both of\n"
+          "type {:'}";
+};
+
+}  // namespace msg
+
 template <typename F>
 struct self_swap {
     NEO_NO_UNIQUE_ADDRESS F _f;
@@ -468,17 +523,13 @@ struct self_swap {
 
     template <typename X>
     static auto error() {
-        using render::type_v;
+        using err::type_arg_v;
         if constexpr (not invocable<F, X, X>) {
-            return err::fmt_errorex_t<  //
-                maybe_invoke_error_t<F, X, X>,
-                "Self-operator ˜ will binary-invoke function {:'} with left-hand\n"
-                "and right-hand both of type {:'}.\n\n"
-                "Function {:'} is not binary-invocable with α and ω both of\n"
-                "type {:'}",
-                type_v<F>,
-                type_v<X>,
-                type_v<X>>{};
+            return err::msg_errorex_t<maybe_invoke_error_t<F, X, X>,
+                                      msg::self_swap_not_binary,
+                                      type_arg_v<F>,
+                                      type_arg_v<X>,
+                                      type_arg_v<X>>{};
         }
     }
 };
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "./arithmetic.hpp"
+#include "./ranges.hpp"
+
+#include <neo/concepts.hpp>
+#include <neo/type_traits.hpp>
+
+#include <cstddef>
+#include <ranges>
+#include <type_traits>
+
+/**
+ * Reduction and prefix-scan kernels for arithmetic binops over contiguous ranges.
+ *
+ * The plain loops in fold and scan carry a dependency through the accumulator on every element,
+ * which prevents the compiler from vectorizing or overlapping the operations. The kernels here
+ * instead split the input across several independent accumulators and combine them at the end.
+ * This *reassociates* the operation, so it is only used for types where that produces the same
+ * result as the plain loop (See enable_reassociation_v).
+ */
+
+namespace lmno::stdlib {
+
+namespace _sr = std::ranges;
+
+/**
+ * @brief Specialize as `true` to allow fold and scan to reassociate arithmetic on the given type.
+ *
+ * This is enabled by default for integers. For floating-point types, reassociation changes the
+ * rounding of the result, so it must be opted-into explicitly, e.g.:
+ *
+ *      template <>
+ *      constexpr bool lmno::stdlib::enable_reassociation_v<double> = true;
+ */
+template <typename T>
+constexpr bool enable_reassociation_v = neo::integral<T> and not neo::same_as<T, bool>;
+
+namespace kernel {
+
+// Integral arithmetic is done in the unsigned domain, so that reassociation can't introduce
+// overflow that would not occur in the original order. The result is the same modulo 2ⁿ
+template <typename T>
+using wrapping_t
+    = std::conditional_t<neo::integral<T>, std::make_unsigned<T>, std::type_identity<T>>::type;
+
+/**
+ * @brief Describe how a kernel applies the binop `Func`. Specializations must provide a static
+ * `apply(T, T) -> T`
+ */
+template <typename Func>
+struct op_traits {
+    constexpr static bool associative = false;
+};
+
+template <>
+struct op_traits<stdlib::plus> {
+    constexpr static bool associative = true;
+
+    template <typename T>
+    constexpr static T apply(T a, T b) noexcept {
+        return static_cast<T>(static_cast<wrapping_t<T>>(a) + static_cast<wrapping_t<T>>(b));
+    }
+};
+
+template <>
+struct op_traits<stdlib::times_or_sign> {
+    constexpr static bool associative = true;
+
+    template <typename T>
+    constexpr static T apply(T a, T b) noexcept {
+        return static_cast<T>(static_cast<wrapping_t<T>>(a) * static_cast<wrapping_t<T>>(b));
+    }
+};
+
+template <>
+struct op_traits<stdlib::min_or_floor> {
+    constexpr static bool associative = true;
+
+    template <typename T>
+    constexpr static T apply(T a, T b) noexcept {
+        return static_cast<T>(stdlib::_min(a, b));
+    }
+};
+
+template <>
+struct op_traits<stdlib::max_or_ceil> {
+    constexpr static bool associative = true;
+
+    template <typename T>
+    constexpr static T apply(T a, T b) noexcept {
+        return static_cast<T>(stdlib::_max(a, b));
+    }
+};
+
+/**
+ * @brief Match an arithmetic type that kernels will operate on. Narrow integers are excluded since
+ * arithmetic on them is promoted to `int`.
+ */
+template <typename T>
+concept kernel_value = (neo::integral<T> and sizeof(T) >= sizeof(int)) or neo::floating_point<T>;
+
+/**
+ * @brief Match a fold/scan of the range R with binop Func and accumulator type Acc that can be
+ * computed by a kernel, producing the same result as the plain loop.
+ */
+template <typename Func, typename Acc, typename R>
+concept reassociable =                                 //
+    op_traits<neo::remove_cvref_t<Func>>::associative  //
+    and kernel_value<Acc>                              //
+    and enable_reassociation_v<Acc>                    //
+    and _sr::contiguous_range<as_range_t<R>>           //
+    and _sr::sized_range<as_range_t<R>>                //
+    and kernel_value<range_value_t<R>>                 //
+    and neo::same_as<std::common_type_t<Acc, range_value_t<R>>, Acc>;
+
+/**
+ * @brief Reduce the `n` elements at `in` using the binop Func, starting with `init`
+ *
+ * The accumulators are spelled out as separate variables (rather than an array) so that they
+ * remain in registers even when the optimizer does not unroll loops.
+ */
+template <typename Func, typename Acc, typename T>
+constexpr Acc reduce(Acc init, const T* in, std::size_t n) noexcept {
+    using op = op_traits<Func>;
+    if (n < 8) {
+        for (std::size_t i = 0; i < n; ++i) {
+            init = op::apply(init, static_cast<Acc>(in[i]));
+        }
+        return init;
+    }
+    // Seed each accumulator with an element, so no identity-element is needed
+    Acc         a0 = static_cast<Acc>(in[0]);
+    Acc         a1 = static_cast<Acc>(in[1]);
+    Acc         a2 = static_cast<Acc>(in[2]);
+    Acc         a3 = static_cast<Acc>(in[3]);
+    std::size_t i  = 4;
+    for (; i + 4 <= n; i += 4) {
+        a0 = op::apply(a0, static_cast<Acc>(in[i + 0]));
+        a1 = op::apply(a1, static_cast<Acc>(in[i + 1]));
+        a2 = op::apply(a2, static_cast<Acc>(in[i + 2]));
+        a3 = op::apply(a3, static_cast<Acc>(in[i + 3]));
+    }
+    for (; i < n; ++i) {
+        a0 = op::apply(a0, static_cast<Acc>(in[i]));
+    }
+    return op::apply(init, op::apply(op::apply(a0, a1), op::apply(a2, a3)));
+}
+
+/**
+ * @brief Compute the inclusive prefix-scan of the `n` elements at `in` using the binop Func,
+ * starting with `init`, and write the results to `out`. Returns the final accumulated value.
+ *
+ * The input is divided into four blocks. A first pass computes the total of each block (with the
+ * blocks' loops interleaved so that they do not depend on one another), then the starting value
+ * of each block is computed from the totals of the blocks before it, and then a second pass scans
+ * the blocks in the same interleaved fashion. This does twice as many operations as the plain
+ * loop, but each pass has four independent dependency chains.
+ */
+template <typename Func, typename Acc, typename T>
+constexpr Acc scan(Acc init, const T* in, std::size_t n, Acc* out) noexcept {
+    using op = op_traits<Func>;
+    if (n < 32) {
+        for (std::size_t i = 0; i < n; ++i) {
+            init   = op::apply(init, static_cast<Acc>(in[i]));
+            out[i] = init;
+        }
+        return init;
+    }
+    const std::size_t block = n / 4;
+    const T*          in0   = in;
+    const T*          in1   = in0 + block;
+    const T*          in2   = in1 + block;
+    const T*          in3   = in2 + block;
+    // Pass 1: Compute the total of each block
+    Acc a0 = static_cast<Acc>(in0[0]);
+    Acc a1 = static_cast<Acc>(in1[0]);
+    Acc a2 = static_cast<Acc>(in2[0]);
+    Acc a3 = static_cast<Acc>(in3[0]);
+    for (std::size_t i = 1; i < block; ++i) {
+        a0 = op::apply(a0, static_cast<Acc>(in0[i]));
+        a1 = op::apply(a1, static_cast<Acc>(in1[i]));
+        a2 = op::apply(a2, static_cast<Acc>(in2[i]));
+        a3 = op::apply(a3, static_cast<Acc>(in3[i]));
+    }
+    // Convert the block totals into the starting value of each block
+    a3 = op::apply(op::apply(op::apply(init, a0), a1), a2);
+    a2 = op::apply(op::apply(init, a0), a1);
+    a1 = op::apply(init, a0);
+    a0 = init;
+    // Pass 2: Scan each block, starting at its offset
+    Acc* out0 = out;
+    Acc* out1 = out0 + block;
+    Acc* out2 = out1 + block;
+    Acc* out3 = out2 + block;
+    for (std::size_t i = 0; i < block; ++i) {
+        out0[i] = a0 = op::apply(a0, static_cast<Acc>(in0[i]));
+        out1[i] = a1 = op::apply(a1, static_cast<Acc>(in1[i]));
+        out2[i] = a2 = op::apply(a2, static_cast<Acc>(in2[i]));
+        out3[i] = a3 = op::apply(a3, static_cast<Acc>(in3[i]));
+    }
+    // The remainder that did not divide evenly into the blocks
+    for (std::size_t i = block * 4; i < n; ++i) {
+        a3     = op::apply(a3, static_cast<Acc>(in[i]));
+        out[i] = a3;
+    }
+    return a3;
+}
+
+}  // namespace kernel
+
+}  // namespace lmno::stdlib
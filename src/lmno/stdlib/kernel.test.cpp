@@ -0,0 +1,80 @@
+#include "./kernel.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace kernel = lmno::stdlib::kernel;
+using lmno::stdlib::max_or_ceil;
+using lmno::stdlib::min_or_floor;
+using lmno::stdlib::plus;
+using lmno::stdlib::times_or_sign;
+
+namespace {
+
+template <std::size_t N>
+constexpr auto make_input() {
+    std::array<std::int64_t, N> arr{};
+    for (std::size_t i = 0; i < N; ++i) {
+        // Some values that go up and down
+        arr[i] = static_cast<std::int64_t>((i * 7919) % 103) - 50;
+    }
+    return arr;
+}
+
+template <typename Func, std::size_t N>
+constexpr bool check_reduce() {
+    auto         arr  = make_input<N>();
+    std::int64_t init = 3;
+    std::int64_t acc  = init;
+    for (auto v : arr) {
+        acc = kernel::op_traits<Func>::apply(acc, v);
+    }
+    return kernel::reduce<Func>(init, arr.data(), N) == acc;
+}
+
+template <typename Func, std::size_t N>
+constexpr bool check_scan() {
+    auto                        arr  = make_input<N>();
+    std::array<std::int64_t, N> out  = {};
+    std::int64_t                init = 3;
+    auto                        last = kernel::scan<Func>(init, arr.data(), N, out.data());
+    std::int64_t                acc  = init;
+    for (std::size_t i = 0; i < N; ++i) {
+        acc = kernel::op_traits<Func>::apply(acc, arr[i]);
+        if (out[i] != acc) {
+            return false;
+        }
+    }
+    return last == acc;
+}
+
+// Sizes that are below, at, and not a multiple of the number of accumulators
+static_assert(check_reduce<plus, 0>());
+static_assert(check_reduce<plus, 5>());
+static_assert(check_reduce<plus, 16>());
+static_assert(check_reduce<plus, 1001>());
+static_assert(check_reduce<times_or_sign, 77>());
+static_assert(check_reduce<min_or_floor, 333>());
+static_assert(check_reduce<max_or_ceil, 333>());
+
+static_assert(check_scan<plus, 0>());
+static_assert(check_scan<plus, 7>());
+static_assert(check_scan<plus, 32>());
+static_assert(check_scan<plus, 1001>());
+static_assert(check_scan<max_or_ceil, 517>());
+
+// Overflowing intermediate values do not change the result
+constexpr std::array<std::int64_t, 20> big = {
+    std::numeric_limits<std::int64_t>::max(), 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -2,
+};
+static_assert(kernel::reduce<plus>(std::int64_t(0), big.data(), big.size())
+              == std::numeric_limits<std::int64_t>::max() - 2);
+
+// Only integers reassociate by default
+static_assert(kernel::reassociable<plus, std::int64_t, std::array<std::int64_t, 4>&>);
+static_assert(not kernel::reassociable<plus, double, std::array<double, 4>&>);
+static_assert(not kernel::reassociable<lmno::stdlib::minus_or_negative, int, std::array<int, 4>&>);
+
+}  // namespace
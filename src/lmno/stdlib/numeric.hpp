@@ -3,16 +3,23 @@
 #include "../define.hpp"
 #include "../invoke.hpp"
 #include "../render.hpp"
+#include "./algorithm.hpp"
 #include "./arithmetic.hpp"
 #include "./constants.hpp"
+#include "./kernel.hpp"
 #include "./logic.hpp"
 #include "./ranges.hpp"
+#include "./small_vector.hpp"
 
 #include <neo/attrib.hpp>
+#include <neo/declval.hpp>
 #include <neo/returns.hpp>
 #include <neo/type_traits.hpp>
 
+#include <functional>
+#include <limits>
 #include <ranges>
+#include <vector>
 
 namespace lmno::stdlib {
 
@@ -30,12 +37,19 @@ namespace _sv = std::views;
 888      "Y88P"  888  "Y88888
 */
 
+namespace msg {
+
+struct no_identity_element {
+    static constexpr cx_str text = "No identity-element for type {:'} with binary operation {:'}";
+};
+
+}  // namespace msg
+
 template <typename T, typename Operator>
 constexpr auto make_no_id_elem_error_str() {
-    constexpr auto M = cx_fmt_v<"No identity-element for type {:'} with binary operation {:'}",
-                                render::type_v<T>,
-                                render::type_v<Operator>>;
-    return err::error_type<M>{};
+    return err::msg_error_t<msg::no_identity_element,
+                            err::type_arg_v<T>,
+                            err::type_arg_v<Operator>>{};
 }
 
 template <typename Type, typename Operator>
@@ -53,12 +67,42 @@ constexpr I identity_element<I, stdlib::times_or_sign> = I(1);
 template <neo::integral I>
 constexpr I identity_element<I, stdlib::divide_or_reciprocal> = I(1);
 
+template <neo::integral I>
+constexpr I identity_element<I, stdlib::min_or_floor> = std::numeric_limits<I>::max();
+
+template <neo::integral I>
+constexpr I identity_element<I, stdlib::max_or_ceil> = std::numeric_limits<I>::lowest();
+
 template <neo::integral I>
 constexpr int identity_element<I, stdlib::and_> = int(1);
 
 template <neo::integral I>
 constexpr int identity_element<I, stdlib::or_> = int(0);
 
+namespace msg {
+
+struct fold_not_input_range {
+    static constexpr cx_str text = "The argument must be an input range (Got {:'})";
+};
+
+struct fold_elements_not_binary {
+    static constexpr cx_str text
+        = "The range elements (of type {:'}) are not valid operands for the binary "
+          "function {:'}";
+};
+
+struct fold_init_not_input_range {
+    static constexpr cx_str text = "The right-hand argument {:'} is not an input-range";
+};
+
+struct fold_no_common_init_type {
+    static constexpr cx_str text
+        = "There is no common type between the init-value of type {:'} and the range's "
+          "element type {:'}";
+};
+
+}  // namespace msg
+
 template <typename Func>
 struct fold {
     NEO_NO_UNIQUE_ADDRESS Func _binop;
@@ -78,8 +122,26 @@ struct fold {
                  }
     constexpr static auto _run(Binop& binop, Init init, R&& in) {
         auto value = static_cast<common_type_t<Init, Ref>>(init);
-        for (Ref el : as_range(in)) {
-            value = lmno::invoke(binop, NEO_MOVE(value), NEO_FWD(el));
+        if constexpr (is_over_each_view_v<neo::remove_cvref_t<R>>) {
+            // Folding over an over-each: Apply the mapped function and the binop in a single pass
+            // over the underlying range, rather than pulling each element through a transform_view.
+            // Like transform_view, we operate on copies of the (cheap-to-copy) view and function.
+            auto view = in._view;
+            auto func = in._func;
+            for (auto&& el : view) {
+                value = lmno::invoke(binop, NEO_MOVE(value), std::invoke(func, NEO_FWD(el)));
+            }
+        } else if constexpr (kernel::reassociable<Binop, decltype(value), R>) {
+            // An associative arithmetic op over contiguous values: Use a multi-accumulator kernel
+            auto&& rng = as_range(in);
+            value      = kernel::reduce<neo::remove_cvref_t<Binop>>(value,
+                                                               _sr::data(rng),
+                                                               static_cast<std::size_t>(
+                                                                   _sr::size(rng)));
+        } else {
+            for (Ref el : as_range(in)) {
+                value = lmno::invoke(binop, NEO_MOVE(value), NEO_FWD(el));
+            }
         }
         return value;
     }
@@ -103,36 +165,30 @@ struct fold {
     template <typename Arg>
     constexpr static auto error() noexcept {
         if constexpr (not input_range_convertible<Arg>) {
-            return err::fmt_error_t<"The argument must be an input range (Got {:'})",
-                                    render::type_v<Arg>>{};
+            return err::msg_error_t<msg::fold_not_input_range, err::type_arg_v<Arg>>{};
         } else if constexpr (not invocable<Func, range_reference_t<Arg>, range_reference_t<Arg>>) {
-            return err::fmt_errorex_t<
+            return err::msg_errorex_t<
                 invoke_error_t<Func, range_reference_t<Arg>, range_reference_t<Arg>>,
-                "The range elements (of type {:'}) are not valid operands for the binary "
-                "function {:'}",
-                render::type_v<range_reference_t<Arg>>,
-                render::type_v<Func>>{};
+                msg::fold_elements_not_binary,
+                err::type_arg_v<range_reference_t<Arg>>,
+                err::type_arg_v<Func>>{};
         }
     }
 
     template <typename Init, typename Arg>
     constexpr static auto error() noexcept {
         if constexpr (not input_range_convertible<Arg>) {
-            return err::fmt_error_t<"The right-hand argument {:'} is not an input-range",
-                                    render::type_v<Arg>>{};
+            return err::msg_error_t<msg::fold_init_not_input_range, err::type_arg_v<Arg>>{};
         } else if constexpr (not neo::has_common_type<unconst_t<Init>, range_reference_t<Arg>>) {
-            return err::fmt_error_t<
-                "There is no common type between the init-value of type {:'} and the range's "
-                "element type {:'}",
-                render::type_v<Init>,
-                render::type_v<range_reference_t<Arg>>>{};
+            return err::msg_error_t<msg::fold_no_common_init_type,
+                                    err::type_arg_v<Init>,
+                                    err::type_arg_v<range_reference_t<Arg>>>{};
         } else if constexpr (not invocable<Func, range_reference_t<Arg>, range_reference_t<Arg>>) {
-            return err::fmt_errorex_t<
+            return err::msg_errorex_t<
                 invoke_error_t<Func, range_reference_t<Arg>, range_reference_t<Arg>>,
-                "The range elements (of type {:'}) are not valid operands for the binary "
-                "function {:'}",
-                render::type_v<range_reference_t<Arg>>,
-                render::type_v<Func>>{};
+                msg::fold_elements_not_binary,
+                err::type_arg_v<range_reference_t<Arg>>,
+                err::type_arg_v<Func>>{};
         }
     }
 };
@@ -149,6 +205,135 @@ Y88b  d88P Y88b.    888  888 888  888
  "Y8888P"   "Y8888P "Y888888 888  888
 */
 
+/**
+ * @brief A lazy inclusive scan of a view: Each element is computed from the previous one as the
+ * view is iterated. Use with CTAD.
+ *
+ * This is used by scan for ranges that cannot be materialized up-front (e.g. "⍳∞"). Each
+ * increment of an iterator calls the binop once, so taking the first N elements of a scan is O(N)
+ * and does not allocate.
+ */
+template <typename Func, _sr::view V, typename Value>
+struct scan_view : _sr::view_interface<scan_view<Func, V, Value>> {
+    NEO_NO_UNIQUE_ADDRESS Func  _binop;
+    NEO_NO_UNIQUE_ADDRESS V     _view;
+    NEO_NO_UNIQUE_ADDRESS Value _init;
+
+    scan_view() = default;
+
+    constexpr explicit scan_view(Func f, V v, Value init)
+        : _binop(NEO_MOVE(f))
+        , _view(NEO_MOVE(v))
+        , _init(NEO_MOVE(init)) {}
+
+    template <bool Const>
+    class _iterator {
+        using Parent = std::conditional_t<Const, const scan_view, scan_view>;
+        using Base   = std::conditional_t<Const, const V, V>;
+
+        Parent*               _parent = nullptr;
+        _sr::iterator_t<Base> _it{};
+        // The accumulated value up-to and including the element at _it
+        Value _acc{};
+
+        constexpr void _accumulate() {
+            if (_it != _sr::end(_parent->_view)) {
+                _acc = _parent->_binop(NEO_MOVE(_acc), *_it);
+            }
+        }
+
+    public:
+        using iterator_concept = std::conditional_t<_sr::forward_range<Base>,
+                                                    std::forward_iterator_tag,
+                                                    std::input_iterator_tag>;
+        using value_type       = Value;
+        using difference_type  = _sr::range_difference_t<Base>;
+
+        _iterator() = default;
+
+        constexpr _iterator(Parent& p, _sr::iterator_t<Base> it)
+            : _parent(&p)
+            , _it(NEO_MOVE(it))
+            , _acc(p._init) {
+            _accumulate();
+        }
+
+        constexpr Value operator*() const { return _acc; }
+
+        constexpr _iterator& operator++() {
+            ++_it;
+            _accumulate();
+            return *this;
+        }
+
+        constexpr void operator++(int) { ++*this; }
+
+        constexpr _iterator operator++(int)
+            requires _sr::forward_range<Base>
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr bool operator==(const _iterator& other) const
+            requires std::equality_comparable<_sr::iterator_t<Base>>
+        {
+            return _it == other._it;
+        }
+
+        constexpr bool operator==(const _sr::sentinel_t<Base>& s) const { return _it == s; }
+    };
+
+    constexpr auto begin() { return _iterator<false>{*this, _sr::begin(_view)}; }
+    constexpr auto end() { return _sr::end(_view); }
+
+    constexpr auto begin() const
+        requires _sr::range<const V>
+    {
+        return _iterator<true>{*this, _sr::begin(_view)};
+    }
+
+    constexpr auto end() const
+        requires _sr::range<const V>
+    {
+        return _sr::end(_view);
+    }
+
+    constexpr auto size()
+        requires _sr::sized_range<V>
+    {
+        return _sr::size(_view);
+    }
+
+    constexpr auto size() const
+        requires _sr::sized_range<const V>
+    {
+        return _sr::size(_view);
+    }
+};
+LMNO_AUTO_CTAD_GUIDE(scan_view);
+
+namespace scan_detail {
+
+/**
+ * @brief Obtain the range of cells that scan::into should write into for the given output. A
+ * multi-dimensional array (e.g. md::mdvector) is written through its zero-cells.
+ */
+template <typename Out>
+constexpr decltype(auto) output_cells(Out& out) {
+    if constexpr (requires { out.zero_cells(); }) {
+        return out.zero_cells();
+    } else {
+        return (out);
+    }
+}
+
+template <typename Out>
+using output_cells_t = decltype(output_cells(NEO_DECLVAL(Out&)));
+
+}  // namespace scan_detail
+
 // The "\" closure
 template <typename Func>
 struct scan {
@@ -191,26 +376,95 @@ struct scan {
 
     template <typename R, typename Value>
     constexpr static auto _scan(auto&& func, Value value, R&& in) {
+        // An associative arithmetic op over contiguous values can use a multi-accumulator kernel
+        constexpr bool use_kernel = kernel::reassociable<decltype(func), Value, R>;
+        using kernel_op           = neo::remove_cvref_t<decltype(func)>;
         if constexpr (typed_constant<R> and (_sr::random_access_range<R> or _sr::sized_range<R>)
                       and neo::default_initializable<Value>) {
             constexpr auto          size = static_cast<std::size_t>(_sr::distance(R{}));
             std::array<Value, size> _arr;
-            _scan_into(_arr.begin(), func, value, in);
+            if constexpr (use_kernel) {
+                kernel::scan<kernel_op>(value, _sr::data(in), size, _arr.data());
+            } else {
+                _scan_into(_arr.begin(), func, value, in);
+            }
             return _arr;
+        } else if constexpr (not _sr::sized_range<R> and _sr::viewable_range<R>) {
+            // We don't know how many elements there are (there may be infinitely many), so
+            // compute them on-demand
+            using F = neo::remove_cvref_t<decltype(func)>;
+            return scan_view{F(func), _sv::all(NEO_FWD(in)), NEO_MOVE(value)};
+        } else if constexpr (_sr::sized_range<R> and std::semiregular<Value>) {
+            // We know exactly how many elements there will be. Short results are stored inline.
+            const auto          size = static_cast<std::size_t>(_sr::size(in));
+            small_vector<Value> out(size);
+            if constexpr (use_kernel) {
+                kernel::scan<kernel_op>(value, _sr::data(in), size, out.data());
+            } else {
+                _scan_into(out.begin(), func, value, in);
+            }
+            return out;
         } else {
             std::vector<decltype(value)> vec;
+            if constexpr (_sr::sized_range<R>) {
+                vec.reserve(static_cast<std::size_t>(_sr::size(in)));
+            }
             _scan_into(std::back_inserter(vec), func, value, in);
             return vec;
         }
     }
 
-    constexpr static void _scan_into(auto out, auto&& fn, auto& value, auto& range) {
+    constexpr static auto _scan_into(auto out, auto&& fn, auto& value, auto& range) {
         for (decltype(auto) el : range) {
             value  = fn(NEO_MOVE(value), NEO_FWD(el));
             *out++ = value;
         }
+        return out;
+    }
+
+    /**
+     * @brief Scan the range `in` starting with `init`, writing the results into caller-provided
+     * storage rather than allocating a new result.
+     *
+     * @param out An output range, or a multi-dimensional array that has `zero_cells()` (e.g.
+     * md::mdvector). Must have room for every element of `in`.
+     * @return An iterator past the last element that was written to `out`
+     */
+    template <typename Out,
+              typename Init,
+              input_range_convertible    R,
+              neo::has_common_type<Init> Ref = range_reference_t<R>,
+              typename Value                 = common_type_t<Init, Ref>>
+        requires(invocable<Func, Value, Ref>
+                 and neo::assignable_from<Value&, invoke_t<Func, Value, Ref>>
+                 and _sr::output_range<scan_detail::output_cells_t<Out>, const Value&>)
+    constexpr auto into(Out&& out, Init&& init, R&& in) const {
+        auto&& cells = scan_detail::output_cells(out);
+        auto&& rng   = as_range(NEO_FWD(in));
+        using Cells  = decltype(cells);
+        using Rng    = decltype(rng);
+        if constexpr (_sr::sized_range<Cells> and _sr::sized_range<Rng>) {
+            if (_sr::size(cells) < _sr::size(rng)) {
+                throw "The output range is too small to hold the result of the scan";
+            }
+        }
+        auto value = static_cast<Value>(NEO_FWD(init));
+        if constexpr (kernel::reassociable<Func, Value, Rng> and _sr::contiguous_range<Cells>
+                      and neo::same_as<_sr::range_value_t<Cells>, Value>) {
+            const auto size = static_cast<std::size_t>(_sr::size(rng));
+            kernel::scan<Func>(value, _sr::data(rng), size, _sr::data(cells));
+            return _sr::begin(cells) + static_cast<_sr::range_difference_t<Cells>>(size);
+        } else {
+            return _scan_into(_sr::begin(cells), _binop, value, rng);
+        }
     }
 
+    template <typename Out, typename R, input_range_convertible Ru = unconst_t<R>>
+    constexpr auto into(Out&& out, R&& in) const
+        NEO_RETURNS(this->into(NEO_FWD(out),
+                               identity_element<range_value_t<Ru>, Func>,
+                               NEO_FWD(in)));
+
     // Defer to 'fold', which produces the same error messages
     template <typename... Args>
     static auto error() NEO_RETURNS(fold<Func>::template error<Args...>());
@@ -249,6 +503,18 @@ struct iota_range : _sr::view_interface<iota_range<Max>> {
 };
 LMNO_AUTO_CTAD_GUIDE(iota_range);
 
+namespace msg {
+
+struct iota_not_infix {
+    static constexpr cx_str text = "Iota {:'} is not infix-invocable";
+};
+
+struct iota_not_incrementable {
+    static constexpr cx_str text = "Iota operand {:'} is not an incrementable type";
+};
+
+}  // namespace msg
+
 struct iota {
     LMNO_INDIRECT_INVOCABLE(iota);
 
@@ -261,14 +527,13 @@ struct iota {
 
     template <typename W, typename X>
     static auto error() {
-        return err::fmt_error_t<"Iota {:'} is not infix-invocable", cx_str{"⍳"}>{};
+        return err::msg_error_t<msg::iota_not_infix, cx_str{"⍳"}>{};
     }
 
     template <typename X>
     static auto error() {
         if constexpr (not std::incrementable<X>) {
-            return err::fmt_error_t<"Iota operand {:'} is not an incrementable type",
-                                    render::type_v<X>>{};
+            return err::msg_error_t<msg::iota_not_incrementable, err::type_arg_v<X>>{};
         }
     }
 };
@@ -287,11 +552,23 @@ struct iota {
                            888
 */
 
+namespace msg {
+
+struct drop_count_not_integral {
+    static constexpr cx_str text = "The left-hand operand of type {:'} is not an integral value";
+};
+
+struct drop_not_viewable_range {
+    static constexpr cx_str text = "The right-hand operand of type {:'} is not a viewable-range";
+};
+
+}  // namespace msg
+
 struct drop {
     LMNO_INDIRECT_INVOCABLE(drop);
 
     constexpr auto call(neo::integral auto n, viewable_range_convertible auto&& r) const noexcept {
-        return _sv::drop(as_range(r), static_cast<std::int64_t>(n));
+        return _sv::drop(as_range(NEO_FWD(r)), static_cast<std::int64_t>(n));
     }
 
     template <typename N,
@@ -300,11 +577,9 @@ struct drop {
               typename Ru = unconst_t<R>>
     constexpr auto error() {
         if constexpr (not neo::integral<Nu>) {
-            return err::fmt_error_t<"The left-hand operand of type {:'} is not an integral value",
-                                    render::type_v<N>>{};
+            return err::msg_error_t<msg::drop_count_not_integral, err::type_arg_v<N>>{};
         } else if constexpr (not viewable_range_convertible<Ru>) {
-            return err::fmt_error_t<"The right-hand operand of type {:'} is not a viewable-range",
-                                    render::type_v<R>>{};
+            return err::msg_error_t<msg::drop_not_viewable_range, err::type_arg_v<R>>{};
         }
     }
 };
@@ -320,6 +595,18 @@ struct drop {
     888  "Y888888 888  888  "Y8888
 */
 
+namespace msg {
+
+struct take_count_not_integral {
+    static constexpr cx_str text = "Left-hand operand of type {:'} is not an integral type";
+};
+
+struct take_not_viewable_range {
+    static constexpr cx_str text = "Right-hand operand of type {:'} is not a viewable-range";
+};
+
+}  // namespace msg
+
 struct take {
     LMNO_INDIRECT_INVOCABLE(take);
 
@@ -332,11 +619,9 @@ struct take {
               typename Ru = unconst_t<R>>
     static auto error() {
         if constexpr (not neo::integral<Nu>) {
-            return err::fmt_error_t<"Left-hand operand of type {:'} is not an integral type",
-                                    render::type_v<N>>{};
+            return err::msg_error_t<msg::take_count_not_integral, err::type_arg_v<N>>{};
         } else if constexpr (not viewable_range_convertible<Ru>) {
-            return err::fmt_error_t<"Right-hand operand of type {:'} is not a viewable-range",
-                                    render::type_v<R>>{};
+            return err::msg_error_t<msg::take_not_viewable_range, err::type_arg_v<R>>{};
         }
     }
 };
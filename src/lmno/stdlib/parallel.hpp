@@ -0,0 +1,364 @@
+#pragma once
+
+#include "../define.hpp"
+#include "../invoke.hpp"
+#include "./algorithm.hpp"
+#include "./arithmetic.hpp"
+#include "./kernel.hpp"
+#include "./logic.hpp"
+#include "./numeric.hpp"
+#include "./ranges.hpp"
+
+#include <neo/attrib.hpp>
+#include <neo/returns.hpp>
+#include <neo/type_traits.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace lmno::stdlib {
+
+namespace _sr = std::ranges;
+
+/*
+8888888b.                                 888 888          888
+888   Y88b                                888 888          888
+888    888                                888 888          888
+888   d88P  8888b.  888d888  8888b.       888 888  .d88b.  888
+8888888P"      "88b 888P"       "88b      888 888 d8P  Y8b 888
+888        .d888888 888     .d888888      888 888 88888888 888
+888        888  888 888     888  888      888 888 Y8b.     888
+888        "Y888888 888     "Y888888      888 888  "Y8888  888
+*/
+
+namespace par_detail {
+
+/// The smallest number of elements that is worth handing to a separate thread
+constexpr std::size_t min_chunk_size = 1 << 15;
+
+/// Binops that may be regrouped, and so can be split into partial reductions
+template <typename Op>
+constexpr bool associative_v = kernel::op_traits<Op>::associative;
+
+template <>
+constexpr inline bool associative_v<stdlib::and_> = true;
+
+template <>
+constexpr inline bool associative_v<stdlib::or_> = true;
+
+/// Functions that have a parallel implementation
+template <typename F>
+constexpr bool has_parallel_v = false;
+
+template <typename Op>
+constexpr bool has_parallel_v<fold<Op>> = true;
+
+template <typename Op>
+constexpr bool has_parallel_v<scan<Op>> = true;
+
+template <typename F>
+constexpr bool has_parallel_v<over_each<F>> = true;
+
+/**
+ * @brief Match a range that can be split between threads
+ */
+template <typename R>
+concept splittable_range = _sr::random_access_range<as_range_t<R>>  //
+    and _sr::sized_range<as_range_t<R>>                              //
+    and (not typed_constant<neo::remove_cvref_t<R>>);
+
+/**
+ * @brief Match a range that can be split into partial reductions using the binop Op
+ */
+template <typename Op, typename R>
+concept reducible = associative_v<neo::remove_cvref_t<Op>>  //
+    and splittable_range<R>                                 //
+    and non_error<decltype(identity_element<range_value_t<R>, neo::remove_cvref_t<Op>>)>;
+
+/**
+ * @brief Obtain the number of chunks to split `n` elements into.
+ */
+inline std::size_t chunk_count(std::size_t n) noexcept {
+    const std::size_t hw = (std::max)(1u, std::thread::hardware_concurrency());
+    return std::clamp(n / min_chunk_size, std::size_t(1), hw);
+}
+
+/**
+ * @brief Call `fn(chunk, begin, end)` for each of `nchunks` chunks of the range of indices [0, n),
+ * each on a separate thread, and wait for them to complete.
+ *
+ * Chunks begin on a multiple of 64 elements, so that two threads never write to the same word of a
+ * bit-packed output (i.e. std::vector<bool>). If any chunk throws, the exception of the first such
+ * chunk is rethrown on the calling thread once every chunk has finished.
+ */
+template <typename Fn>
+void fork_join(std::size_t n, std::size_t nchunks, Fn&& fn) {
+    auto bound = [&](std::size_t c) {
+        return c == nchunks ? n : (n * c / nchunks) & ~std::size_t(63);
+    };
+    std::vector<std::exception_ptr> errors(nchunks);
+    auto                            run = [&](std::size_t c) {
+        try {
+            fn(c, bound(c), bound(c + 1));
+        } catch (...) {
+            errors[c] = std::current_exception();
+        }
+    };
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(nchunks - 1);
+        for (std::size_t c = 1; c < nchunks; ++c) {
+            threads.emplace_back(run, c);
+        }
+        // The calling thread takes the first chunk
+        run(0);
+        // (jthread joins on destruction)
+    }
+    for (auto& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+/**
+ * @brief Obtain the [lo, hi) elements of the given range, as a view of the same kind
+ */
+template <typename R>
+constexpr auto slice(R&& in, std::size_t lo, std::size_t hi) {
+    if constexpr (is_over_each_view_v<neo::remove_cvref_t<R>>) {
+        // Keep the over-each so that fold can still fuse the mapping with the reduction
+        return over_each_view{in._func, slice(in._view, lo, hi)};
+    } else {
+        auto&& rng = as_range(in);
+        auto   it  = _sr::begin(rng);
+        using diff = _sr::range_difference_t<decltype(rng)>;
+        return _sr::subrange(it + static_cast<diff>(lo), it + static_cast<diff>(hi));
+    }
+}
+
+}  // namespace par_detail
+
+namespace msg {
+
+struct not_parallelizable {
+    static constexpr cx_str text
+        = "The {:'} modifier can only be applied to {:'}, {:'}, or {:'} (Got {:'})";
+};
+
+}  // namespace msg
+
+/**
+ * @brief Wraps a function to execute in parallel. Use with CTAD.
+ *
+ * @tparam F The function to execute in parallel.
+ *
+ * Only fold "/", scan "\", and over-each "¨" have parallel implementations. The modifier may be
+ * applied either to the function they create (e.g. "∥/:+"), or to "/", "\", or "¨" themselves (e.g.
+ * "∥:/:+"), in which case the function that they create is made parallel. For fold and scan,
+ * the binop must be associative and have an identity_element for the range's value type. The
+ * range must be random-access and sized. Other invocations fall back to the regular sequential
+ * implementation. Evaluation in a constant expression is always sequential.
+ *
+ * @note This is created using the "∥" modifier, e.g. "∥:/:+"
+ */
+template <typename F>
+struct parallel {
+    NEO_NO_UNIQUE_ADDRESS F _fn;
+
+    LMNO_INDIRECT_INVOCABLE(parallel);
+
+    // Applied to a function that creates a fold, scan, or over-each (e.g. "∥:/:+"), the created
+    // function is made parallel.
+    template <typename Arg>
+        requires par_detail::has_parallel_v<neo::remove_cvref_t<invoke_t<const F&, Arg>>>
+    constexpr auto call(Arg&& arg) const {
+        using Inner = neo::remove_cvref_t<invoke_t<const F&, Arg>>;
+        return parallel<Inner>{lmno::invoke(_fn, NEO_FWD(arg))};
+    }
+
+    template <typename... Args>
+    static auto error() {
+        return err::msg_error_t<msg::not_parallelizable,
+                                cx_str{"∥"},
+                                cx_str{"/"},
+                                cx_str{"\\"},
+                                cx_str{"¨"},
+                                err::type_arg_v<F>>{};
+    }
+};
+LMNO_AUTO_CTAD_GUIDE(parallel);
+
+// Parallel fold: Each thread reduces a chunk starting from the identity-element, then the partial
+// results are combined in order.
+template <typename Op>
+struct parallel<fold<Op>> {
+    NEO_NO_UNIQUE_ADDRESS fold<Op> _fn;
+
+    LMNO_INDIRECT_INVOCABLE(parallel);
+
+    template <typename R>
+    constexpr auto call(R&& in) const -> decltype(_fn.call(NEO_FWD(in))) {
+        if constexpr (par_detail::reducible<Op, R>) {
+            return this->_reduce(identity_element<range_value_t<R>, Op>, in);
+        } else {
+            return _fn.call(NEO_FWD(in));
+        }
+    }
+
+    template <typename Init, typename R>
+    constexpr auto call(Init&& init, R&& in) const
+        -> decltype(_fn.call(NEO_FWD(init), NEO_FWD(in))) {
+        if constexpr (par_detail::reducible<Op, R>) {
+            return this->_reduce(NEO_FWD(init), in);
+        } else {
+            return _fn.call(NEO_FWD(init), NEO_FWD(in));
+        }
+    }
+
+    template <typename Init, typename R>
+    constexpr auto _reduce(Init&& init, R& in) const {
+        using Value       = decltype(_fn.call(NEO_FWD(init), in));
+        const auto n      = static_cast<std::size_t>(_sr::size(as_range(in)));
+        const auto chunks = std::is_constant_evaluated() ? 1 : par_detail::chunk_count(n);
+        if (chunks == 1) {
+            return _fn.call(NEO_FWD(init), in);
+        }
+        using Partial = decltype(_fn.call(identity_element<range_value_t<R>, Op>,
+                                          par_detail::slice(in, 0, n)));
+        std::vector<Partial> partials(chunks);
+        par_detail::fork_join(n, chunks, [&](std::size_t c, std::size_t lo, std::size_t hi) {
+            partials[c] = _fn.call(identity_element<range_value_t<R>, Op>,
+                                   par_detail::slice(in, lo, hi));
+        });
+        auto value = static_cast<Value>(NEO_FWD(init));
+        for (auto& p : partials) {
+            value = lmno::invoke(_fn._binop, NEO_MOVE(value), NEO_MOVE(p));
+        }
+        return value;
+    }
+
+    template <typename... Args>
+    static auto error() NEO_RETURNS(fold<Op>::template error<Args...>());
+};
+
+// Parallel scan: Compute the total of each chunk, derive the starting value of each chunk from the
+// totals before it, then scan each chunk.
+template <typename Op>
+struct parallel<scan<Op>> {
+    NEO_NO_UNIQUE_ADDRESS scan<Op> _fn;
+
+    LMNO_INDIRECT_INVOCABLE(parallel);
+
+    template <typename R>
+    constexpr auto call(R&& in) const -> decltype(_fn.call(NEO_FWD(in))) {
+        if constexpr (par_detail::reducible<Op, R>) {
+            return this->_scan(identity_element<range_value_t<R>, Op>, in);
+        } else {
+            return _fn.call(NEO_FWD(in));
+        }
+    }
+
+    template <typename Init, typename R>
+    constexpr auto call(Init&& init, R&& in) const
+        -> decltype(_fn.call(NEO_FWD(init), NEO_FWD(in))) {
+        if constexpr (par_detail::reducible<Op, R>) {
+            return this->_scan(NEO_FWD(init), in);
+        } else {
+            return _fn.call(NEO_FWD(init), NEO_FWD(in));
+        }
+    }
+
+    template <typename Init, typename R>
+    constexpr auto _scan(Init&& init, R& in) const {
+        using Result      = decltype(_fn.call(NEO_FWD(init), in));
+        using Value       = typename Result::value_type;
+        const auto n      = static_cast<std::size_t>(_sr::size(as_range(in)));
+        const auto chunks = std::is_constant_evaluated() ? 1 : par_detail::chunk_count(n);
+        if (chunks == 1) {
+            return _fn.call(NEO_FWD(init), in);
+        }
+        const fold<Op> folder{_fn._binop};
+        std::vector<Value> offsets(chunks);
+        par_detail::fork_join(n, chunks, [&](std::size_t c, std::size_t lo, std::size_t hi) {
+            offsets[c] = static_cast<Value>(folder.call(identity_element<range_value_t<R>, Op>,
+                                                        par_detail::slice(in, lo, hi)));
+        });
+        // Convert the totals into the starting value of each chunk
+        auto value = static_cast<Value>(NEO_FWD(init));
+        for (auto& off : offsets) {
+            auto total = NEO_MOVE(off);
+            off        = value;
+            value      = lmno::invoke(_fn._binop, NEO_MOVE(value), NEO_MOVE(total));
+        }
+        Result out(n);
+        par_detail::fork_join(n, chunks, [&](std::size_t c, std::size_t lo, std::size_t hi) {
+            auto chunk = par_detail::slice(in, lo, hi);
+            scan<Op>::_scan_into(out.begin() + static_cast<std::ptrdiff_t>(lo),
+                                 _fn._binop,
+                                 offsets[c],
+                                 chunk);
+        });
+        return out;
+    }
+
+    template <typename... Args>
+    static auto error() NEO_RETURNS(scan<Op>::template error<Args...>());
+};
+
+// Parallel over-each: Eagerly computes the results into a vector
+template <typename F>
+struct parallel<over_each<F>> {
+    NEO_NO_UNIQUE_ADDRESS over_each<F> _fn;
+
+    LMNO_INDIRECT_INVOCABLE(parallel);
+
+    template <typename R>
+    using result_value_t
+        = neo::remove_cvref_t<std::invoke_result_t<const F&, range_reference_t<R>>>;
+
+    template <typename R>
+    constexpr auto call(R&& in) const -> decltype(_fn.call(NEO_FWD(in))) {
+        return _fn.call(NEO_FWD(in));
+    }
+
+    template <par_detail::splittable_range R>
+        requires invocable<F, range_reference_t<R>>
+        and neo::default_initializable<result_value_t<R>>
+        and neo::assignable_from<result_value_t<R>&, result_value_t<R>>
+    constexpr auto call(R&& in) const {
+        auto&&                         rng = as_range(in);
+        const auto                     n   = static_cast<std::size_t>(_sr::size(rng));
+        std::vector<result_value_t<R>> out(n);
+        const auto fill = [&](std::size_t, std::size_t lo, std::size_t hi) {
+            auto it = _sr::begin(rng) + static_cast<_sr::range_difference_t<decltype(rng)>>(lo);
+            for (auto i = lo; i < hi; ++i, ++it) {
+                out[i] = std::invoke(_fn._fn, *it);
+            }
+        };
+        const auto chunks = std::is_constant_evaluated() ? 1 : par_detail::chunk_count(n);
+        if (chunks == 1) {
+            fill(0, 0, n);
+        } else {
+            par_detail::fork_join(n, chunks, fill);
+        }
+        return out;
+    }
+
+    template <typename... Args>
+    static auto error() NEO_RETURNS(over_each<F>::template error<Args...>());
+};
+
+}  // namespace lmno::stdlib
+
+namespace lmno {
+
+template <>
+constexpr inline auto define<"∥"> = [](auto&& f) NEO_RETURNS_L(stdlib::parallel{NEO_FWD(f)});
+
+}  // namespace lmno
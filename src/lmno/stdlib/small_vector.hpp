@@ -0,0 +1,97 @@
+#pragma once
+
+#include <neo/fwd.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lmno::stdlib {
+
+/// The default number of elements for a small_vector to store inline: As many as fit in 64 bytes
+template <typename T>
+constexpr std::size_t default_inline_capacity_v = (std::max)(std::size_t(1), 64 / sizeof(T));
+
+/**
+ * @brief A fixed-size contiguous array of values that stores up to N elements inline, and only
+ * allocates when it is larger than that.
+ *
+ * @tparam T The element type.
+ * @tparam N The number of elements that can be stored without allocating.
+ *
+ * This is the result type of materialized scans of runtime ranges, which are often short.
+ */
+template <std::semiregular T, std::size_t N = default_inline_capacity_v<T>>
+class small_vector {
+    std::array<T, N> _inline{};
+    std::vector<T>   _heap;
+    std::size_t      _size = 0;
+
+    constexpr bool _is_inline() const noexcept { return _size <= N; }
+
+public:
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using iterator       = T*;
+    using const_iterator = const T*;
+
+    small_vector() = default;
+
+    /// Create a small_vector of `n` value-initialized elements
+    constexpr explicit small_vector(std::size_t n)
+        : _size(n) {
+        if (not _is_inline()) {
+            _heap.resize(n);
+        }
+    }
+
+    small_vector(const small_vector&)            = default;
+    small_vector& operator=(const small_vector&) = default;
+
+    // A moved-from small_vector is empty
+    constexpr small_vector(small_vector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+        : _inline(NEO_MOVE(other._inline))
+        , _heap(NEO_MOVE(other._heap))
+        , _size(std::exchange(other._size, 0)) {}
+
+    constexpr small_vector&
+    operator=(small_vector&& other) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        _inline = NEO_MOVE(other._inline);
+        _heap   = NEO_MOVE(other._heap);
+        _size   = std::exchange(other._size, 0);
+        return *this;
+    }
+
+    /// The number of elements that can be stored without allocating
+    constexpr static std::size_t inline_capacity() noexcept { return N; }
+
+    constexpr T*       data() noexcept { return _is_inline() ? _inline.data() : _heap.data(); }
+    constexpr const T* data() const noexcept {
+        return _is_inline() ? _inline.data() : _heap.data();
+    }
+
+    constexpr std::size_t size() const noexcept { return _size; }
+    constexpr bool        empty() const noexcept { return _size == 0; }
+
+    constexpr T*       begin() noexcept { return data(); }
+    constexpr const T* begin() const noexcept { return data(); }
+    constexpr T*       end() noexcept { return data() + _size; }
+    constexpr const T* end() const noexcept { return data() + _size; }
+
+    constexpr T&       operator[](std::size_t n) noexcept { return data()[n]; }
+    constexpr const T& operator[](std::size_t n) const noexcept { return data()[n]; }
+
+    friend constexpr bool operator==(const small_vector& lhs, const small_vector& rhs) noexcept
+        requires std::equality_comparable<T>
+    {
+        return std::ranges::equal(lhs, rhs);
+    }
+};
+
+}  // namespace lmno::stdlib
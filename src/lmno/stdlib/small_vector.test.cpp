@@ -0,0 +1,77 @@
+#include "./small_vector.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <string>
+#include <type_traits>
+
+using lmno::stdlib::small_vector;
+
+static_assert(std::ranges::contiguous_range<small_vector<int>>);
+static_assert(std::ranges::sized_range<small_vector<int>>);
+static_assert(small_vector<std::int64_t>::inline_capacity() == 8);
+static_assert(small_vector<char>::inline_capacity() == 64);
+
+namespace {
+
+template <std::size_t Size>
+constexpr bool check_fill() {
+    small_vector<int, 4> vec(Size);
+    if (vec.size() != Size) {
+        return false;
+    }
+    for (std::size_t i = 0; i < Size; ++i) {
+        vec[i] = static_cast<int>(i);
+    }
+    // Copies and moves preserve the elements
+    auto copy  = vec;
+    auto moved = std::move(vec);
+    return copy == moved and vec.empty()
+        and std::ranges::equal(moved, std::views::iota(0, static_cast<int>(Size)));
+}
+
+// Inline, at capacity, and on the heap
+static_assert(check_fill<0>());
+static_assert(check_fill<3>());
+static_assert(check_fill<4>());
+static_assert(check_fill<100>());
+
+// Records whether it was ever copied
+struct copy_marked {
+    bool copied = false;
+
+    copy_marked() = default;
+    constexpr copy_marked(const copy_marked&) noexcept
+        : copied(true) {}
+    constexpr copy_marked& operator=(const copy_marked&) noexcept {
+        copied = true;
+        return *this;
+    }
+    copy_marked(copy_marked&&) noexcept            = default;
+    copy_marked& operator=(copy_marked&&) noexcept = default;
+};
+
+// Moving a small_vector moves its inline elements instead of copying them
+constexpr bool check_move_inline() {
+    small_vector<copy_marked, 4> vec(3);
+    auto                         moved = std::move(vec);
+    small_vector<copy_marked, 4> assigned;
+    assigned = std::move(moved);
+    return std::ranges::none_of(assigned, &copy_marked::copied);
+}
+static_assert(check_move_inline());
+
+// Whose move may throw
+struct throwing_move {
+    throwing_move() = default;
+    throwing_move(const throwing_move&) {}
+    throwing_move& operator=(const throwing_move&) { return *this; }
+};
+
+static_assert(std::is_nothrow_move_constructible_v<small_vector<std::string>>);
+static_assert(std::is_nothrow_move_assignable_v<small_vector<std::string>>);
+static_assert(not std::is_nothrow_move_constructible_v<small_vector<throwing_move>>);
+static_assert(not std::is_nothrow_move_assignable_v<small_vector<throwing_move>>);
+
+}  // namespace
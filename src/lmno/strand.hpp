@@ -1,10 +1,12 @@
 #pragma once
 
 #include "./concepts/typed_constant.hpp"
+#include "./rational.hpp"
 
 #include <neo/fwd.hpp>
 #include <neo/iterator_facade.hpp>
 
+#include <array>
 #include <concepts>
 #include <tuple>
 
@@ -12,13 +14,67 @@ namespace lmno {
 
 struct strand_range_construct_tag_t {};
 
+namespace detail {
+
+template <typename... Ts>
+concept strand_elements = requires { typename std::common_type_t<unconst_t<Ts>...>; };
+
+template <typename... Ts>
+using strand_value_t = neo::remove_cvref_t<std::common_type_t<unconst_t<Ts>...>>;
+
+/**
+ * @brief Match strand elements that can be stored contiguously as an array of their common value
+ * type: Either every element has the exact same (unconst'd) type, or they are all arithmetic.
+ */
+template <typename... Ts>
+concept contiguous_strand_elements =            //
+    strand_elements<Ts...>                      //
+    and std::semiregular<strand_value_t<Ts...>>  //
+    and ((std::same_as<neo::remove_cvref_t<unconst_t<Ts>>, strand_value_t<Ts...>>
+          or (arithmetic<neo::remove_cvref_t<unconst_t<Ts>>>
+              and arithmetic<strand_value_t<Ts...>>))
+         and ...);
+
+/// Contiguous storage for the elements of a strand
+template <typename T, typename... Ts>
+struct strand_array {
+    std::array<T, sizeof...(Ts)> _arr;
+
+    strand_array() = default;
+
+    template <typename... Us>
+    constexpr explicit strand_array(Us&&... us)
+        : _arr{static_cast<T>(lmno::unconst(NEO_FWD(us)))...} {}
+
+    constexpr const T* data() const noexcept { return _arr.data(); }
+};
+
+/// If every element is a typed constant, the array is static and the strand remains stateless
+template <typename T, typed_constant... Cs>
+struct strand_array<T, Cs...> {
+    static constexpr std::array<T, sizeof...(Cs)> _arr{static_cast<T>(Cs::value)...};
+
+    strand_array() = default;
+
+    template <typename... Us>
+    constexpr explicit strand_array(Us&&...) noexcept {}
+
+    constexpr const T* data() const noexcept { return _arr.data(); }
+};
+
+}  // namespace detail
+
 /**
  * @brief A range constructed from‿a‿strand‿expression
  *
  * @tparam Ts The types of the strand elements. Must share a common type
+ *
+ * If the elements share a common value type (See `detail::contiguous_strand_elements`), the
+ * elements are stored in an array and the range is contiguous. Otherwise, they are stored in a
+ * tuple and each dereference must dispatch on the element index.
  */
 template <typename... Ts>
-    requires requires { typename std::common_type_t<unconst_t<Ts>...>; }
+    requires detail::strand_elements<Ts...>
 class strand_range {
     using tuple_type = std::tuple<Ts...>;
     NEO_NO_UNIQUE_ADDRESS tuple_type _tpl;
@@ -74,6 +130,28 @@ public:
     constexpr _ref operator[](std::size_t pos) const noexcept { return begin()[pos]; }
 };
 
+template <typename... Ts>
+    requires detail::contiguous_strand_elements<Ts...>
+class strand_range<Ts...> {
+    using value_type = detail::strand_value_t<Ts...>;
+    NEO_NO_UNIQUE_ADDRESS detail::strand_array<value_type, Ts...> _elems;
+
+public:
+    strand_range() = default;
+
+    template <std::convertible_to<Ts>... Us>
+    constexpr strand_range(strand_range_construct_tag_t, Us&&... us)
+        : _elems(NEO_FWD(us)...) {}
+
+    constexpr const value_type* begin() const noexcept { return _elems.data(); }
+    constexpr const value_type* end() const noexcept { return _elems.data() + sizeof...(Ts); }
+    constexpr const value_type* data() const noexcept { return _elems.data(); }
+
+    constexpr static std::size_t size() noexcept { return sizeof...(Ts); }
+
+    constexpr const value_type& operator[](std::size_t pos) const noexcept { return data()[pos]; }
+};
+
 template <typename... Ts>
 strand_range(strand_range_construct_tag_t, const Ts&...) -> strand_range<Ts...>;
 
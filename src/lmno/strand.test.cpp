@@ -1,6 +1,23 @@
 #include "./strand.hpp"
 
+#include "./const.hpp"
+
 #include <ranges>
 
 static_assert(std::ranges::random_access_range<lmno::strand_range<int, int, int, int>>);
 
+using lmno::Const;
+using lmno::strand_range;
+using lmno::strand_range_construct_tag_t;
+
+// Strands with a common value type are stored contiguously
+static_assert(std::ranges::contiguous_range<strand_range<int, int, int>>);
+static_assert(std::ranges::contiguous_range<strand_range<int, long, double>>);
+static_assert(std::same_as<std::ranges::range_value_t<strand_range<int, long>>, long>);
+// Typed constants are stored in static storage, so the strand remains stateless
+static_assert(std::ranges::contiguous_range<strand_range<Const<1>, Const<2>>>);
+static_assert(std::is_empty_v<strand_range<Const<1>, Const<2>, Const<3>>>);
+static_assert(strand_range<Const<1>, Const<2>, Const<3>>{}[2] == 3);
+// Mixed constants and runtime values
+constexpr auto mixed = strand_range{strand_range_construct_tag_t{}, Const<1>{}, 2, 3};
+static_assert(mixed[0] == 1 and mixed[1] == 2 and mixed.size() == 3);
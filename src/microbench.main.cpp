@@ -0,0 +1,319 @@
+/**
+ * Runtime micro-benchmarks: Compare evaluated lmno programs against equivalent hand-written C++.
+ *
+ * For each program and size, reports the best-observed time per element for both the lmno program
+ * and the handwritten loop, as well as the ratio between the two (the "abstraction overhead"). A
+ * ratio near 1.0 means the program compiled down to the same code as the loop.
+ *
+ * Build this with optimizations enabled, otherwise the numbers are meaningless.
+ */
+
+#include <lmno/eval.hpp>
+#include <lmno/rt.hpp>
+#include <lmno/stdlib.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using i64   = std::int64_t;
+using clock = std::chrono::steady_clock;
+
+/// Prevent the optimizer from discarding a computed value
+template <typename T>
+void keep(T const& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/// Prevent the optimizer from assuming anything about the contents of a value
+template <typename T>
+void clobber(T& value) {
+    asm volatile("" : "+g"(value) : : "memory");
+}
+
+/**
+ * @brief Obtain the best time-per-element (in nanoseconds) for running `fn` on `n` elements.
+ *
+ * The function is run repeatedly in batches long enough to give stable clock readings, and the
+ * fastest batch is kept.
+ */
+template <typename F>
+double ns_per_element(i64 n, F&& fn) {
+    constexpr auto min_batch   = std::chrono::milliseconds(20);
+    constexpr int  num_batches = 7;
+
+    // Find a repetition count that fills a batch
+    i64 reps = 1;
+    while (true) {
+        auto start = clock::now();
+        for (i64 r = 0; r < reps; ++r) {
+            fn();
+        }
+        if (clock::now() - start >= min_batch) {
+            break;
+        }
+        reps *= 2;
+    }
+
+    auto best = clock::duration::max();
+    for (int b = 0; b < num_batches; ++b) {
+        auto start = clock::now();
+        for (i64 r = 0; r < reps; ++r) {
+            fn();
+        }
+        best = (std::min)(best, clock::now() - start);
+    }
+    auto ns = std::chrono::duration<double, std::nano>(best).count();
+    return ns / static_cast<double>(reps) / static_cast<double>(n);
+}
+
+std::vector<i64> make_input(i64 n) {
+    std::vector<i64> vec(static_cast<std::size_t>(n));
+    std::iota(vec.begin(), vec.end(), i64(1));
+    return vec;
+}
+
+void report(std::string_view name, i64 n, double lmno_ns, double cxx_ns) {
+    // Pad by code points rather than by bytes, since the program names are mostly non-ASCII
+    auto width = std::ranges::count_if(name, [](char c) { return (c & 0xc0) != 0x80; });
+    std::printf("| %.*s%*s | %9lld | %10.3f | %10.3f | %8.2fx |\n",
+                static_cast<int>(name.size()),
+                name.data(),
+                static_cast<int>((std::max)(i64(0), 24 - width)),
+                "",
+                static_cast<long long>(n),
+                lmno_ns,
+                cxx_ns,
+                lmno_ns / cxx_ns);
+}
+
+// "/+" : Sum a vector
+void bench_fold(i64 n) {
+    constexpr auto sum   = lmno::eval<"/+">();
+    auto           input = make_input(n);
+    auto           lm    = ns_per_element(n, [&] {
+        clobber(input);
+        keep(sum(input));
+    });
+    auto cx = ns_per_element(n, [&] {
+        clobber(input);
+        i64 acc = 0;
+        for (auto v : input) {
+            acc += v;
+        }
+        keep(acc);
+    });
+    report("/+", n, lm, cx);
+}
+
+// "/:+∘⍳" : Sum an integer sequence
+void bench_fold_iota(i64 n) {
+    constexpr auto sum_iota = lmno::eval<"/:+∘⍳">();
+    auto           lm       = ns_per_element(n, [&] {
+        auto len = n;
+        clobber(len);
+        keep(sum_iota(len));
+    });
+    auto cx = ns_per_element(n, [&] {
+        auto len = n;
+        clobber(len);
+        i64 acc = 0;
+        for (i64 i = 0; i < len; ++i) {
+            acc += i;
+        }
+        keep(acc);
+    });
+    report("/:+∘⍳", n, lm, cx);
+}
+
+// "∥:/:+∘⍳" : Sum an integer sequence, split across threads
+void bench_par_fold_iota(i64 n) {
+    constexpr auto sum_iota = lmno::eval<"∥:/:+∘⍳">();
+    auto           lm       = ns_per_element(n, [&] {
+        auto len = n;
+        clobber(len);
+        keep(sum_iota(len));
+    });
+    auto cx = ns_per_element(n, [&] {
+        auto len = n;
+        clobber(len);
+        i64 acc = 0;
+        for (i64 i = 0; i < len; ++i) {
+            acc += i;
+        }
+        keep(acc);
+    });
+    report("∥:/:+∘⍳", n, lm, cx);
+}
+
+// "\+" : Prefix-sum of a vector
+void bench_scan(i64 n) {
+    constexpr auto scan  = lmno::eval<"\\+">();
+    auto           input = make_input(n);
+    auto           lm    = ns_per_element(n, [&] {
+        clobber(input);
+        keep(scan(input));
+    });
+    auto cx = ns_per_element(n, [&] {
+        clobber(input);
+        std::vector<i64> out;
+        i64              acc = 0;
+        for (auto v : input) {
+            acc += v;
+            out.push_back(acc);
+        }
+        keep(out);
+    });
+    report("\\+", n, lm, cx);
+}
+
+// "¨{2×ω}" : Transform each element, then consume the result
+void bench_over_each(i64 n) {
+    constexpr auto twice = lmno::eval<"¨{2×ω}">();
+    auto           input = make_input(n);
+    auto           lm    = ns_per_element(n, [&] {
+        clobber(input);
+        i64 acc = 0;
+        for (auto v : twice(input).as_range()) {
+            acc ^= v;
+        }
+        keep(acc);
+    });
+    auto cx = ns_per_element(n, [&] {
+        clobber(input);
+        i64 acc = 0;
+        for (auto v : input) {
+            acc ^= 2 * v;
+        }
+        keep(acc);
+    });
+    report("¨{2×ω}", n, lm, cx);
+}
+
+// "/:+∘¨:{ω×ω}" : Sum of squares (fold over a transformed range)
+void bench_fold_over_each(i64 n) {
+    constexpr auto sum_sq = lmno::eval<"/:+∘¨:{ω×ω}">();
+    auto           input  = make_input(n);
+    auto           lm     = ns_per_element(n, [&] {
+        clobber(input);
+        keep(sum_sq(input));
+    });
+    auto cx = ns_per_element(n, [&] {
+        clobber(input);
+        i64 acc = 0;
+        for (auto v : input) {
+            acc += v * v;
+        }
+        keep(acc);
+    });
+    report("/:+∘¨:{ω×ω}", n, lm, cx);
+}
+
+// "{/+$ω‿ω‿ω‿ω‿ω‿ω‿ω‿ω}" : Fold over a runtime strand, once per element
+void bench_strand(i64 n) {
+    constexpr auto strand_sum = lmno::eval<"{/+$ω‿ω‿ω‿ω‿ω‿ω‿ω‿ω}">();
+    auto           input      = make_input(n);
+    auto           lm         = ns_per_element(n, [&] {
+        clobber(input);
+        i64 acc = 0;
+        for (auto v : input) {
+            acc += strand_sum(v);
+        }
+        keep(acc);
+    });
+    auto cx = ns_per_element(n, [&] {
+        clobber(input);
+        i64 acc = 0;
+        for (auto v : input) {
+            acc += v + v + v + v + v + v + v + v;
+        }
+        keep(acc);
+    });
+    report("{/+$ω‿ω‿ω‿ω‿ω‿ω‿ω‿ω}", n, lm, cx);
+}
+
+// "{(ω×ω)+1}" : Call a runtime-compiled function once per element, both by walking the syntax
+// tree (rt:) and on the bytecode machine (vm:)
+void bench_runtime_call(i64 n) {
+    constexpr std::string_view code  = "{(ω×ω)+1}";
+    auto                       input = make_input(n);
+    auto                       run   = [&](const lmno::rt::function& fn) {
+        return ns_per_element(n, [&] {
+            clobber(input);
+            i64 acc = 0;
+            for (auto v : input) {
+                acc += fn(v).get<i64>();
+            }
+            keep(acc);
+        });
+    };
+    auto tree = run(lmno::rt::compile(code)().get<lmno::rt::function>());
+    auto vm   = run(lmno::rt::compile_bytecode(code)().get<lmno::rt::function>());
+    auto cx   = ns_per_element(n, [&] {
+        clobber(input);
+        i64 acc = 0;
+        for (auto v : input) {
+            acc += v * v + 1;
+        }
+        keep(acc);
+    });
+    report("rt:{(ω×ω)+1}", n, tree, cx);
+    report("vm:{(ω×ω)+1}", n, vm, cx);
+}
+
+// "{/:+ $ (ω×ω)+1}" : Evaluate a runtime-compiled function over a whole column at once
+void bench_array_engine(i64 n) {
+    auto prog  = lmno::rt::compile_array("{/:+ $ (ω×ω)+1}");
+    auto input = make_input(n);
+    auto lm    = ns_per_element(n, [&] {
+        clobber(input);
+        keep(std::get<i64>(prog(input)));
+    });
+    auto cx = ns_per_element(n, [&] {
+        clobber(input);
+        i64 acc = 0;
+        for (auto v : input) {
+            acc += v * v + 1;
+        }
+        keep(acc);
+    });
+    report("col:{/:+ $ (ω×ω)+1}", n, lm, cx);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<i64> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::atoll(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {16, 1'024, 65'536, 1'048'576};
+    }
+
+    std::printf("| %-24s | %9s | %10s | %10s | %9s |\n",
+                "program",
+                "N",
+                "lmno ns/el",
+                "C++ ns/el",
+                "overhead");
+    std::printf("|--------------------------|-----------|------------|------------|-----------|\n");
+    for (auto n : sizes) {
+        bench_fold(n);
+        bench_fold_iota(n);
+        bench_par_fold_iota(n);
+        bench_scan(n);
+        bench_over_each(n);
+        bench_fold_over_each(n);
+        bench_strand(n);
+        bench_runtime_call(n);
+        bench_array_engine(n);
+    }
+}
@@ -0,0 +1,382 @@
+"""
+Compile-time benchmarks for lmno.
+
+Generates translation units that each contain many lmno programs, compiles them
+with the toolchains in `tools/`, and reports how much compile time is spent in
+each phase of the pipeline:
+
+- ``lex``: ``lmno::lex::tokenize_t<Code>``
+- ``parse``: ``lmno::parse_t<Code>`` (minus ``lex``)
+- ``eval``: ``decltype(lmno::eval<Code>())`` (minus ``parse``)
+- ``fast``: ``decltype(lmno::eval<Code>(lmno::fast_sema{}))`` (minus ``parse``),
+  for comparison with ``eval``
+- ``probe``: Whether the result of ``eval`` can be invoked with a
+  ``std::string`` (minus ``eval``). The probe always fails, as the checks
+  within a successful program often do, but the error is never displayed.
+
+Each phase is measured by compiling a TU that stops after that phase, so the
+cost of a phase is the difference between two TUs. A TU with only the
+``#include``\\ s is used as the zero point.
+
+Clang is run with ``-ftime-trace`` and GCC with ``-ftime-report``, and the
+template-instantiation figures from those reports are included in the output.
+Pass ``--no-time-report`` to a GCC that crashes while writing its report (GCC 12
+does, on the ``parse`` TUs), and compare the wall-clock times only.
+
+The lmno dependencies (neo-fun, nameof, Boost.PFR) are not vendored: pass their
+include directories with ``-I``.
+
+Example::
+
+    python tools/bench_compile.py -I ~/deps/neo-fun/src -I ~/deps/nameof/include \\
+        -I ~/deps/pfr/include --save _build/bench/today.json --baseline _build/bench/last.json
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import re
+import subprocess
+import sys
+import time
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Callable, Iterable, Sequence
+
+HERE = Path(__file__).parent.resolve()
+ROOT = HERE.parent
+
+PHASES = ('lex', 'parse', 'eval', 'fast', 'probe')
+#: The phase that each phase builds upon
+PREV_PHASE = {'lex': 'base', 'parse': 'lex', 'eval': 'parse', 'fast': 'parse', 'probe': 'eval'}
+
+
+def gen_train(idx: int, size: int) -> str:
+    """A long train of infix arithmetic: ``1 + 2 × 3 - ...``"""
+    ops = ['+', '×', '-', '⌈', '⌊']
+    parts = [str(idx + 1)]
+    for n in range(size):
+        parts.append(ops[n % len(ops)])
+        parts.append(str(n % 7 + 1))
+    return ' '.join(parts)
+
+
+def gen_strand(idx: int, size: int) -> str:
+    """A single large strand literal: ``1‿2‿3‿...``"""
+    return '‿'.join(str(idx + n) for n in range(size))
+
+
+def gen_block(idx: int, size: int) -> str:
+    """A composition of many blocks: ``({ω+1}∘{ω+2}∘...) 0``"""
+    blocks = '∘'.join(f'{{ω+{n % 9 + 1}}}' for n in range(size))
+    return f'({blocks}) {idx}'
+
+
+def gen_nested_block(idx: int, size: int) -> str:
+    """Deeply nested blocks: ``{{{ω+1} ω} ω} ...``"""
+    inner = f'ω+{idx}'
+    for _ in range(size):
+        inner = f'{{{inner}}} ω'
+    return f'{{{inner}}} {idx}'
+
+
+def gen_shared_block(idx: int, size: int) -> str:
+    """The same large block in every program, applied to different arguments: ``{ω + 1 × ω ...} 0``"""
+    body = ' '.join(['ω'] + [f'{"+×-⌈⌊"[n % 5]} {"ω" if n % 2 else n % 7 + 1}' for n in range(size)])
+    return f'{{{body}}} {idx}'
+
+
+def gen_assign(idx: int, size: int) -> str:
+    """A long statement sequence, with each statement binding a new name: ``a0 ← 1; a1 ← a0+1; ...``"""
+    stmts = [f'a0 ← {idx}'] + [f'a{n} ← a{n - 1}+{n % 9 + 1}' for n in range(1, size)]
+    return '; '.join(stmts) + f'; a{size - 1}'
+
+
+def gen_invoke(idx: int, size: int) -> str:
+    """Many invocations on the argument of a block: ``{ω + 1 × ω - 2 ...} 0``, distinct in every program"""
+    body = ' '.join(['ω'] + [f'{"+×-⌈⌊"[n % 5]} {"ω" if n % 2 else (n + idx) % 7 + 1}' for n in range(size)])
+    return f'{{{body}}} {idx}'
+
+
+#: The program families. Each generator is given the program's index within the
+#: TU (to keep programs distinct from each other) and the "size" knob.
+FAMILIES: dict[str, Callable[[int, int], str]] = {
+    'train': gen_train,
+    'strand': gen_strand,
+    'block': gen_block,
+    'nested-block': gen_nested_block,
+    'shared-block': gen_shared_block,
+    'assign': gen_assign,
+    'invoke': gen_invoke,
+}
+
+#: Default values of the "size" knob for each family, when none are given with ``--size``.
+#: Statement sequences need to be long before the cost of name lookup and rebinding shows. The
+#: cost of resolving each lmno::invoke shows best with over a hundred invocations in a program.
+DEFAULT_SIZES: dict[str, list[int]] = {
+    'assign': [16, 64],
+    'invoke': [128],
+}
+
+
+@dataclass(frozen=True)
+class Toolchain:
+    """The subset of a bpt toolchain file that we need in order to run the compiler"""
+    name: str
+    compiler: str
+    flags: tuple[str, ...]
+    #: Whether to ask GCC for its -ftime-report. GCC 12 crashes in the report on some of our TUs.
+    time_report: bool = True
+
+    @property
+    def is_clang(self) -> bool:
+        return 'clang' in Path(self.compiler).name
+
+
+def _parse_toolchain_yaml(content: str) -> dict[str, str | list[str]]:
+    """
+    Parse the flat subset of YAML used by the files in tools/. We only need
+    scalar keys and block lists, and this avoids a dependency on a YAML library.
+    """
+    ret: dict[str, str | list[str]] = {}
+    cur_list: list[str] | None = None
+    for line in content.splitlines():
+        if not line.strip() or line.lstrip().startswith('#'):
+            continue
+        item = re.match(r'^\s+-\s+(.*)$', line)
+        if item and cur_list is not None:
+            cur_list.append(item.group(1).strip())
+            continue
+        kv = re.match(r'^([a-z_]+):\s*(.*)$', line)
+        if not kv:
+            continue
+        key, val = kv.groups()
+        if val:
+            ret[key] = val.strip()
+            cur_list = None
+        else:
+            cur_list = []
+            ret[key] = cur_list
+    return ret
+
+
+def load_toolchain(path: Path, compiler: str | None, time_report: bool) -> Toolchain:
+    data = _parse_toolchain_yaml(path.read_text())
+    cxx = compiler or data.get('cxx_compiler')
+    assert isinstance(cxx, str), f'No cxx_compiler in {path}'
+    flags = data.get('cxx_flags', [])
+    assert isinstance(flags, list)
+    # Diagnostics tuning flags are irrelevant here and not every compiler version knows them
+    flags = [f for f in flags if not f.startswith('-fconcepts-diagnostics')]
+    return Toolchain(path.stem, cxx, tuple(flags), time_report)
+
+
+def render_tu(phase: str | None, programs: Sequence[str]) -> str:
+    """Generate the source of a TU that runs ``phase`` on each of ``programs``"""
+    lines = [
+        '#include <lmno/eval.hpp>',
+        '#include <lmno/stdlib.hpp>',
+        '',
+        '#include <string>',
+        '',
+    ]
+    for n, prog in enumerate(programs):
+        code = prog.replace('\\', '\\\\').replace('"', '\\"')
+        if phase == 'lex':
+            lines.append(f'using bench_{n} = lmno::lex::tokenize_t<"{code}">;')
+        elif phase == 'parse':
+            lines.append(f'using bench_{n} = lmno::parse_t<"{code}">;')
+        elif phase == 'eval':
+            lines.append(f'using bench_{n} = decltype(lmno::eval<"{code}">());')
+        elif phase == 'fast':
+            lines.append(f'using bench_{n} = decltype(lmno::eval<"{code}">(lmno::fast_sema{{}}));')
+        elif phase == 'probe':
+            lines.append(f'using bench_{n} = decltype(lmno::eval<"{code}">());')
+            lines.append(f'static_assert(not lmno::invocable<bench_{n}, std::string>);')
+        else:
+            assert phase is None, phase
+    return '\n'.join(lines) + '\n'
+
+
+@dataclass
+class Sample:
+    """The measurement of one TU"""
+    seconds: float
+    #: Time spent instantiating templates, as reported by the compiler (seconds)
+    inst_seconds: float | None = None
+    #: Number of instantiations (Clang only)
+    inst_count: int | None = None
+
+
+def _gcc_report(stderr: str) -> float | None:
+    mat = re.search(r'template instantiation\s*:\s*([\d.]+)', stderr)
+    return float(mat.group(1)) if mat else None
+
+
+def _clang_trace(trace_file: Path) -> tuple[float, int]:
+    data = json.loads(trace_file.read_text())
+    events = data.get('traceEvents', [])
+    total_us = 0
+    count = 0
+    for ev in events:
+        if ev.get('name') in ('InstantiateClass', 'InstantiateFunction'):
+            count += 1
+        if ev.get('name') == 'Total PerformPendingInstantiations':
+            total_us += ev.get('dur', 0)
+        elif ev.get('name') == 'Total InstantiateClass':
+            total_us += ev.get('dur', 0)
+    return total_us / 1e6, count
+
+
+def compile_tu(tc: Toolchain, src: Path, includes: Sequence[Path], reps: int) -> Sample:
+    """Compile the TU ``reps`` times and keep the fastest run"""
+    cmd = [tc.compiler, '-std=c++20', '-fsyntax-only', *tc.flags]
+    cmd += [f'-I{p}' for p in (ROOT / 'src', *includes)]
+    if tc.is_clang:
+        cmd += ['-ftime-trace', '-ftime-trace-granularity=0', '-o', str(src.with_suffix('.o'))]
+    elif tc.time_report:
+        cmd.append('-ftime-report')
+    cmd.append(str(src))
+    best: Sample | None = None
+    for _ in range(reps):
+        start = time.perf_counter()
+        res = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, check=False)
+        dur = time.perf_counter() - start
+        if res.returncode != 0:
+            sys.stderr.write(res.stderr.decode(errors='replace')[:4000])
+            raise RuntimeError(f'Compilation of {src} failed with {tc.compiler}')
+        if tc.is_clang:
+            inst, count = _clang_trace(src.with_suffix('.json'))
+            sample = Sample(dur, inst, count)
+        else:
+            sample = Sample(dur, _gcc_report(res.stderr.decode(errors='replace')))
+        if best is None or sample.seconds < best.seconds:
+            best = sample
+    assert best
+    return best
+
+
+@dataclass
+class Result:
+    toolchain: str
+    family: str
+    size: int
+    #: Keys are the phases, plus "base" for the includes-only TU
+    samples: dict[str, Sample] = field(default_factory=lambda: {})
+
+    def phase_cost(self, phase: str) -> float:
+        """The cost of a phase, excluding the cost of the phases before it"""
+        prev = PREV_PHASE[phase]
+        return max(0.0, self.samples[phase].seconds - self.samples[prev].seconds)
+
+    def key(self) -> str:
+        return f'{self.toolchain}/{self.family}/{self.size}'
+
+
+def run_bench(toolchains: Iterable[Toolchain], families: Sequence[str], sizes: Sequence[int] | None, count: int,
+              includes: Sequence[Path], out_dir: Path, reps: int) -> list[Result]:
+    out_dir.mkdir(parents=True, exist_ok=True)
+    results: list[Result] = []
+    for tc in toolchains:
+        base_src = out_dir / f'{tc.name}-base.cpp'
+        base_src.write_text(render_tu(None, []))
+        base = compile_tu(tc, base_src, includes, reps)
+        for fam in families:
+            gen = FAMILIES[fam]
+            for size in sizes or DEFAULT_SIZES.get(fam, [4, 16]):
+                programs = [gen(n, size) for n in range(count)]
+                res = Result(tc.name, fam, size, {'base': base})
+                for phase in PHASES:
+                    src = out_dir / f'{tc.name}-{fam}-{size}-{phase}.cpp'
+                    src.write_text(render_tu(phase, programs))
+                    print(f'  [{tc.name}] {fam} size={size} ({count} programs): {phase} ...', file=sys.stderr)
+                    res.samples[phase] = compile_tu(tc, src, includes, reps)
+                results.append(res)
+    return results
+
+
+def _fmt_ms(sec: float | None) -> str:
+    return '-' if sec is None else f'{sec * 1000:.0f}'
+
+
+def format_table(results: Sequence[Result], baseline: dict[str, dict[str, float]] | None, threshold: float) -> str:
+    head = ['toolchain', 'family', 'size']
+    head += [f'{p} (ms)' for p in PHASES]
+    head += ['inst (ms)', 'inst (#)']
+    if baseline is not None:
+        head += [f'Δ{p}' for p in PHASES]
+    rows: list[list[str]] = [head]
+    regressions: list[str] = []
+    for res in results:
+        row = [res.toolchain, res.family, str(res.size)]
+        row += [_fmt_ms(res.phase_cost(p)) for p in PHASES]
+        ev = res.samples['eval']
+        row += [_fmt_ms(ev.inst_seconds), '-' if ev.inst_count is None else str(ev.inst_count)]
+        if baseline is not None:
+            prev = baseline.get(res.key())
+            for p in PHASES:
+                if prev is None or not prev.get(p):
+                    row.append('new')
+                    continue
+                delta = (res.phase_cost(p) - prev[p]) / prev[p] * 100
+                row.append(f'{delta:+.0f}%')
+                if delta > threshold:
+                    regressions.append(f'{res.key()} {p}: {delta:+.0f}%')
+        rows.append(row)
+    widths = [max(len(r[i]) for r in rows) for i in range(len(head))]
+    lines = ['| ' + ' | '.join(c.ljust(w) for c, w in zip(r, widths)) + ' |' for r in rows]
+    lines.insert(1, '|' + '|'.join('-' * (w + 2) for w in widths) + '|')
+    if regressions:
+        lines += ['', f'Regressions over {threshold:.0f}%:'] + [f'  - {r}' for r in regressions]
+    return '\n'.join(lines)
+
+
+def to_json(results: Sequence[Result]) -> dict[str, dict[str, float]]:
+    return {r.key(): {p: r.phase_cost(p) for p in PHASES} for r in results}
+
+
+def main(argv: Sequence[str]) -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--toolchain',
+                        '-t',
+                        type=Path,
+                        action='append',
+                        help='bpt toolchain file(s) to benchmark (default: all of tools/*.yaml)')
+    parser.add_argument('--compiler', help='Override the compiler executable named in the toolchain file')
+    parser.add_argument('--no-time-report',
+                        dest='time_report',
+                        action='store_false',
+                        help='Do not pass -ftime-report to GCC (only wall-clock times are reported)')
+    parser.add_argument('--include', '-I', type=Path, action='append', default=[], help='Dependency include paths')
+    parser.add_argument('--family', '-f', action='append', choices=sorted(FAMILIES), help='Program families to run')
+    parser.add_argument('--size',
+                        '-s',
+                        type=int,
+                        action='append',
+                        help='Values of the "size" knob (default: 4, 16; 16, 64 for "assign"; 128 for "invoke")')
+    parser.add_argument('--count', '-n', type=int, default=20, help='Number of programs per TU')
+    parser.add_argument('--reps', type=int, default=3, help='Compile each TU this many times and take the fastest')
+    parser.add_argument('--out-dir', type=Path, default=ROOT / '_build/bench', help='Where to write generated TUs')
+    parser.add_argument('--save', type=Path, help='Save the results as JSON to this file')
+    parser.add_argument('--baseline', type=Path, help='Compare against results saved with --save')
+    parser.add_argument('--threshold',
+                        type=float,
+                        default=10.0,
+                        help='Percentage slowdown vs. the baseline reported as a regression')
+    args = parser.parse_args(argv)
+
+    tc_files: list[Path] = args.toolchain or sorted(HERE.glob('*.yaml'))
+    toolchains = [load_toolchain(p, args.compiler, args.time_report) for p in tc_files]
+    results = run_bench(toolchains, args.family or sorted(FAMILIES), args.size, args.count, args.include,
+                        args.out_dir, args.reps)
+    baseline = json.loads(args.baseline.read_text()) if args.baseline else None
+    print(format_table(results, baseline, args.threshold))
+    if args.save:
+        args.save.parent.mkdir(parents=True, exist_ok=True)
+        args.save.write_text(json.dumps(to_json(results), indent=2))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
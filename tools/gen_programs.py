@@ -0,0 +1,102 @@
+"""
+Generate explicit instantiations of lmno programs.
+
+Every translation unit that calls ``lmno::eval<Code>()`` repeats the lexing,
+parsing, and evaluation of ``Code``. For programs that are used throughout a
+project, this script generates:
+
+- A header that declares each program with ``LMNO_EXTERN_PROGRAM``, so that
+  including translation units do not instantiate it.
+- A source file that instantiates each program once with
+  ``LMNO_INSTANTIATE_PROGRAM``.
+
+Programs are listed in a text file, one per line, as the C++ signature of the
+program, an ``=``, and the program code. Blank lines and lines beginning with
+``#`` are ignored::
+
+    # Sum of the integers below N
+    std::int64_t(std::int64_t) = /:+∘⍳
+    std::vector<int>(const std::vector<int>&) = ⌽
+
+Use the programs as ``lmno::program_v<"/:+∘⍳", std::int64_t(std::int64_t)>(n)``.
+If the source file is written within the project's ``src/`` directory, bpt
+compiles it with the rest of the library.
+
+Example::
+
+    python tools/gen_programs.py programs.txt --header src/my/programs.hpp --source src/my/programs.cpp
+"""
+
+from __future__ import annotations
+
+import argparse
+import sys
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Sequence
+
+PREAMBLE = '// Generated by tools/gen_programs.py from {list}. Do not edit.\n'
+
+
+@dataclass(frozen=True)
+class Program:
+    signature: str
+    code: str
+
+    @property
+    def args(self) -> str:
+        """The arguments to the LMNO_*_PROGRAM macros"""
+        return f'{cxx_string(self.code)}, {self.signature}'
+
+
+def cxx_string(code: str) -> str:
+    """Spell the given code as a C++ string literal"""
+    return '"' + code.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def parse_list(content: str, filename: str) -> list[Program]:
+    ret: list[Program] = []
+    for lineno, line in enumerate(content.splitlines(), 1):
+        line = line.strip()
+        if not line or line.startswith('#'):
+            continue
+        sig, eq, code = line.partition(' = ')
+        if not eq or not sig.strip() or not code.strip():
+            raise ValueError(f'{filename}:{lineno}: Expected "<signature> = <code>", got "{line}"')
+        ret.append(Program(sig.strip(), code.strip()))
+    return ret
+
+
+def render_header(programs: Sequence[Program], list_name: str) -> str:
+    decls = ''.join(f'LMNO_EXTERN_PROGRAM({p.args});\n' for p in programs)
+    return f'{PREAMBLE.format(list=list_name)}\n#pragma once\n\n#include <lmno/program.hpp>\n\n{decls}'
+
+
+def render_source(programs: Sequence[Program], list_name: str, header: str) -> str:
+    insts = ''.join(f'LMNO_INSTANTIATE_PROGRAM({p.args});\n' for p in programs)
+    return f'{PREAMBLE.format(list=list_name)}\n#include "{header}"\n\n{insts}'
+
+
+def write_if_changed(path: Path, content: str) -> None:
+    # Leave unchanged outputs alone, so that the build does not recompile their dependents
+    if path.exists() and path.read_text(encoding='utf-8') == content:
+        return
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_text(content, encoding='utf-8')
+
+
+def main(argv: Sequence[str]) -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('list', type=Path, help='The file listing the programs')
+    parser.add_argument('--header', type=Path, required=True, help='The header file to generate')
+    parser.add_argument('--source', type=Path, required=True, help='The source file to generate')
+    args = parser.parse_args(argv)
+
+    programs = parse_list(args.list.read_text(encoding='utf-8'), str(args.list))
+    write_if_changed(args.header, render_header(programs, args.list.name))
+    write_if_changed(args.source, render_source(programs, args.list.name, args.header.name))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))